@@ -1,4 +1,11 @@
 import sys
+import array
+
+# Native engine (pa3sched.c); see that file for the build line.
+try:
+    import pa3sched
+except ImportError:
+    pa3sched = None
 
 #CONSTANTS
 FREQUENCIES = [1188, 918, 648, 384]  # in MHz
@@ -27,6 +34,39 @@ def main():
 
     file = parseInput(input_file)
 
+    if pa3sched is None:
+        print("pa3sched native module not built; see pa3sched.c for the build line")
+        sys.exit(1)
+    result = simulate(file, algorithm, energy_efficient)
+    stats = result['stats']
+    print(f"Summary ({algorithm}{' EE' if energy_efficient else ''}): "
+          f"Completed={stats['completed']}, Preemptions={stats['preemptions']}, "
+          f"Misses={stats['misses']}")
+    print(f"Energy: Busy={stats['energy_busy']:.2f}, Idle={stats['energy_idle']:.2f}, "
+          f"Total={stats['energy_busy'] + stats['energy_idle']:.2f}")
+    # Per-job energies must add up to the busy energy, including the job
+    # still running when the horizon ends.
+    job_energy = sum(memoryview(result['energy']))
+    if abs(job_energy - stats['energy_busy']) > 1e-9 * max(1.0, stats['energy_busy']):
+        print(f"Per-job energy {job_energy:.2f} does not match busy energy "
+              f"{stats['energy_busy']:.2f}", file=sys.stderr)
+        sys.exit(1)
+
+
+def simulate(file, algorithm, energy_efficient):
+    #  Runs the parsed task set through the native engine.
+    #  Per-job columns (task, job, release, start, finish, freq, energy, missed)
+    #  support the buffer protocol: wrap them in memoryview() or
+    #  numpy.frombuffer() to read them without copying.
+    periods = array.array('I', (t['period'] for t in file['tasks']))
+    wcets = array.array('I', (t['wcet'][f] for t in file['tasks'] for f in FREQUENCIES))
+    return pa3sched.simulate(periods, wcets,
+                             policy=algorithm,
+                             ee=energy_efficient,
+                             t_end=file['T_end'],
+                             power=tuple(file['power'][f] for f in FREQUENCIES),
+                             idle_power=file['idle_power'])
+
     
 def parseInput(input_file):
     #  file is space delimited text file. 
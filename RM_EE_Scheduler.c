@@ -1,6 +1,22 @@
+// RM_EE_Scheduler.c
+// Energy-efficient RM with checkpoint/resume of the full simulator state.
+// Build: gcc -O2 -std=c11 RM_EE_Scheduler.c -o rm_ee
+// Run:   ./rm_ee [--end T] [--checkpoint FILE] [--every TICKS]
+//                [--resume FILE] [--freq 0|1|2]
+//   --checkpoint FILE  write a snapshot every TICKS ticks, on SIGUSR1,
+//                      and on SIGINT/SIGTERM (which then stop the run)
+//   --resume FILE      continue bit-identically from a snapshot, up to
+//                      the end it was taken with unless --end is given
+//   --freq F           pin the DVFS level from the resume point onward,
+//                      so several variants can branch from one snapshot
+
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
 
 typedef struct {
     const char *name;
@@ -56,6 +72,7 @@ int rq_highest_rm_idx(const Task *tasks) {
 
 // Simulation parameters
 #define SIMULATION_END 100
+uint64_t simulation_end = SIMULATION_END;
 uint64_t completed = 0;    // Number of completed jobs
 uint64_t preemptions = 0;  // Number of preemptions
 uint64_t misses = 0;       // Number of deadline misses
@@ -65,6 +82,7 @@ double energy_idle = 0.0;  // Energy consumed while idle
 bool cpu_busy = false;
 Job currentJob = {0};
 int currentFrequency = 2; // Start with the highest frequency (0 = low, 1 = medium, 2 = high)
+int freqOverride = -1;    // -1 = dynamic DVFS, otherwise pinned frequency level
 
 // Define the number of tasks
 #define N 3
@@ -104,8 +122,217 @@ int select_frequency(const Task *tasks, const Job *currentJob, double window) {
     return 2; // Default to the highest frequency
 }
 
-int main() {
-    for (uint64_t t = 0; t <= SIMULATION_END; ++t) {
+// ---------- Checkpoint / resume ----------
+// Snapshot layout (native endianness, fields written one by one so struct
+// padding never reaches the file):
+//   "PA3S" | version | N | task table | next tick | simulation_end |
+//   counters | energies |
+//   cpu_busy | currentFrequency | freqOverride | currentJob |
+//   next_seq[N] | readyJobCount | readyJobs[readyJobCount]
+// The task table is stored so a snapshot is rejected by a binary built with
+// different tasks. Doubles are stored raw, which keeps resume bit-identical.
+#define SNAPSHOT_MAGIC   0x53334150u // "PA3S"
+#define SNAPSHOT_VERSION 2u
+
+volatile sig_atomic_t checkpoint_requested = 0;
+volatile sig_atomic_t stop_requested = 0;
+
+void on_checkpoint_signal(int sig) {
+    (void)sig;
+    checkpoint_requested = 1;
+}
+
+void on_stop_signal(int sig) {
+    (void)sig;
+    checkpoint_requested = 1;
+    stop_requested = 1;
+}
+
+bool put(FILE *f, const void *p, size_t n) { return fwrite(p, n, 1, f) == 1; }
+bool get(FILE *f, void *p, size_t n) { return fread(p, n, 1, f) == 1; }
+
+bool put_job(FILE *f, const Job *j) {
+    return put(f, &j->task_id, sizeof j->task_id) &&
+           put(f, &j->release_time, sizeof j->release_time) &&
+           put(f, &j->abs_deadline, sizeof j->abs_deadline) &&
+           put(f, &j->remaining_work, sizeof j->remaining_work) &&
+           put(f, &j->job_seq, sizeof j->job_seq);
+}
+
+bool get_job(FILE *f, Job *j) {
+    return get(f, &j->task_id, sizeof j->task_id) &&
+           get(f, &j->release_time, sizeof j->release_time) &&
+           get(f, &j->abs_deadline, sizeof j->abs_deadline) &&
+           get(f, &j->remaining_work, sizeof j->remaining_work) &&
+           get(f, &j->job_seq, sizeof j->job_seq) &&
+           j->task_id >= 0 && j->task_id < N;
+}
+
+bool put_tasks(FILE *f) {
+    uint32_t n = N;
+    if (!put(f, &n, sizeof n)) return false;
+    for (int i = 0; i < N; ++i) {
+        if (!put(f, &tasks[i].period, sizeof tasks[i].period) ||
+            !put(f, tasks[i].wcet, sizeof tasks[i].wcet) ||
+            !put(f, &tasks[i].deadline, sizeof tasks[i].deadline) ||
+            !put(f, &tasks[i].phase, sizeof tasks[i].phase)) return false;
+    }
+    return true;
+}
+
+bool tasks_match(FILE *f) {
+    uint32_t n;
+    if (!get(f, &n, sizeof n) || n != N) return false;
+    for (int i = 0; i < N; ++i) {
+        Task t;
+        if (!get(f, &t.period, sizeof t.period) ||
+            !get(f, t.wcet, sizeof t.wcet) ||
+            !get(f, &t.deadline, sizeof t.deadline) ||
+            !get(f, &t.phase, sizeof t.phase)) return false;
+        if (t.period != tasks[i].period || t.deadline != tasks[i].deadline ||
+            t.phase != tasks[i].phase ||
+            memcmp(t.wcet, tasks[i].wcet, sizeof t.wcet) != 0) return false;
+    }
+    return true;
+}
+
+// Writes the state reached before tick t. The file is written under a
+// temporary name and renamed, so a kill mid-write keeps the last snapshot.
+bool save_checkpoint(const char *path, uint64_t t) {
+    char tmp[4096];
+    if (snprintf(tmp, sizeof tmp, "%s.tmp", path) >= (int)sizeof tmp) return false;
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+
+    uint32_t magic = SNAPSHOT_MAGIC, version = SNAPSHOT_VERSION;
+    uint8_t busy = cpu_busy;
+    int32_t count = readyJobCount;
+    bool ok = put(f, &magic, sizeof magic) && put(f, &version, sizeof version) &&
+              put_tasks(f) &&
+              put(f, &t, sizeof t) &&
+              put(f, &simulation_end, sizeof simulation_end) &&
+              put(f, &completed, sizeof completed) &&
+              put(f, &preemptions, sizeof preemptions) &&
+              put(f, &misses, sizeof misses) &&
+              put(f, &energy_busy, sizeof energy_busy) &&
+              put(f, &energy_idle, sizeof energy_idle) &&
+              put(f, &busy, sizeof busy) &&
+              put(f, &currentFrequency, sizeof currentFrequency) &&
+              put(f, &freqOverride, sizeof freqOverride) &&
+              put_job(f, &currentJob) &&
+              put(f, next_seq, sizeof next_seq) &&
+              put(f, &count, sizeof count);
+    for (int i = 0; ok && i < readyJobCount; ++i) ok = put_job(f, &readyJobs[i]);
+
+    if (fclose(f) != 0) ok = false;
+    if (!ok || rename(tmp, path) != 0) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+// Restores every global from a snapshot, simulation_end included; *t
+// receives the next tick to run.
+bool load_checkpoint(const char *path, uint64_t *t) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+
+    uint32_t magic, version;
+    uint8_t busy;
+    int32_t count;
+    bool ok = get(f, &magic, sizeof magic) && magic == SNAPSHOT_MAGIC &&
+              get(f, &version, sizeof version) && version == SNAPSHOT_VERSION &&
+              tasks_match(f) &&
+              get(f, t, sizeof *t) &&
+              get(f, &simulation_end, sizeof simulation_end) &&
+              get(f, &completed, sizeof completed) &&
+              get(f, &preemptions, sizeof preemptions) &&
+              get(f, &misses, sizeof misses) &&
+              get(f, &energy_busy, sizeof energy_busy) &&
+              get(f, &energy_idle, sizeof energy_idle) &&
+              get(f, &busy, sizeof busy) &&
+              get(f, &currentFrequency, sizeof currentFrequency) &&
+              get(f, &freqOverride, sizeof freqOverride) &&
+              get_job(f, &currentJob) &&
+              get(f, next_seq, sizeof next_seq) &&
+              get(f, &count, sizeof count) &&
+              count >= 0 && count <= READY_QUEUE_SIZE;
+    readyJobCount = 0;
+    for (int i = 0; ok && i < count; ++i) {
+        ok = get_job(f, &readyJobs[i]);
+        if (ok) readyJobCount = i + 1;
+    }
+    cpu_busy = busy != 0;
+    fclose(f);
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    const char *checkpoint_path = NULL;
+    const char *resume_path = NULL;
+    uint64_t checkpoint_every = 0;
+    int freq_arg = -1;
+    bool end_given = false;
+    uint64_t end_arg = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_path = argv[++i];
+        } else if (strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+            checkpoint_every = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            resume_path = argv[++i];
+        } else if (strcmp(argv[i], "--end") == 0 && i + 1 < argc) {
+            end_arg = strtoull(argv[++i], NULL, 10);
+            end_given = true;
+        } else if (strcmp(argv[i], "--freq") == 0 && i + 1 < argc) {
+            freq_arg = atoi(argv[++i]);
+            if (freq_arg < 0 || freq_arg > 2) freq_arg = -2;
+        } else {
+            freq_arg = -2;
+        }
+        if (freq_arg == -2) {
+            fprintf(stderr, "Usage: %s [--end T] [--checkpoint FILE] [--every TICKS] "
+                            "[--resume FILE] [--freq 0|1|2]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    uint64_t t_start = 0;
+    if (resume_path) {
+        if (!load_checkpoint(resume_path, &t_start)) {
+            fprintf(stderr, "Cannot resume from %s (missing, corrupt or built for other tasks)\n",
+                    resume_path);
+            return 1;
+        }
+        printf("[t=%llu] RESUME from %s\n", (unsigned long long)t_start, resume_path);
+    }
+    if (freq_arg >= 0) freqOverride = freq_arg;
+    if (end_given) simulation_end = end_arg;   // overrides the snapshot's end
+
+    if (checkpoint_path) {
+        signal(SIGUSR1, on_checkpoint_signal);
+        signal(SIGINT, on_stop_signal);
+        signal(SIGTERM, on_stop_signal);
+    }
+
+    for (uint64_t t = t_start; t <= simulation_end; ++t) {
+        // 0) Checkpoint at the tick boundary (periodic or signal-driven)
+        if (checkpoint_path &&
+            (checkpoint_requested ||
+             (checkpoint_every && t > t_start && t % checkpoint_every == 0))) {
+            checkpoint_requested = 0;
+            if (!save_checkpoint(checkpoint_path, t)) {
+                fprintf(stderr, "Checkpoint to %s failed\n", checkpoint_path);
+            }
+            if (stop_requested) {
+                printf("[t=%llu] STOP (state saved to %s)\n",
+                       (unsigned long long)t, checkpoint_path);
+                break;
+            }
+        }
+
         // 1) Releases at time t
         for (int i = 0; i < N; ++i) {
             Task *ti = &tasks[i];
@@ -161,7 +388,7 @@ int main() {
         }
 
         // 4) Frequency selection
-        double window = SIMULATION_END - t; // Default window to the end of the simulation
+        double window = simulation_end - t; // Default window to the end of the simulation
         if (cpu_busy) {
             window = currentJob.abs_deadline - t;
         }
@@ -173,7 +400,8 @@ int main() {
                 window = next_release - t;
             }
         }
-        currentFrequency = select_frequency(tasks, &currentJob, window);
+        currentFrequency = (freqOverride >= 0) ? freqOverride
+                                               : select_frequency(tasks, &currentJob, window);
 
         // 5) Execute the running job
         if (cpu_busy) {
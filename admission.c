@@ -0,0 +1,325 @@
+// admission.c
+// Incremental EDF/RM admission control; see admission.h.
+
+#include "admission.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ADM_MAX_BOUND   UINT64_C(1000000000000)
+#define U_EPS           1e-12
+
+typedef struct {
+    sched_task t;                     // name is not kept
+    int id;
+    uint64_t R[SCHED_NUM_FREQS];      // RM response time (valid where ok[f])
+    uint64_t Rnew[SCHED_NUM_FREQS];   // trial values
+} Entry;
+
+// EDF aggregates of a task set, per level where it matters.
+typedef struct {
+    double U[SCHED_NUM_FREQS];        // sum C_i / T_i
+    double S[SCHED_NUM_FREQS];        // sum (T_i - D_i) * C_i / T_i
+    uint64_t dmax, dmin;
+    int ncons;                        // tasks with D_i < T_i
+} Agg;
+
+struct adm_ctx {
+    sched_policy policy;
+    Entry *e;                         // admitted tasks in RM priority order
+    int n, cap;
+    int next_id;
+    bool ok[SCHED_NUM_FREQS];         // admitted set feasible at level f
+
+    Agg agg;                          // EDF
+    uint64_t crit[SCHED_NUM_FREQS];   // EDF: tightest checkpoint of the last pass
+};
+
+// ---------- Shared helpers ----------
+static uint64_t dbf(const sched_task *t, int f, uint64_t L){
+    if (L < t->deadline) return 0;
+    return ((L - t->deadline) / t->period + 1) * t->wcet[f];
+}
+
+static uint64_t ceil_div(uint64_t a, uint64_t b){
+    return a / b + (a % b != 0);
+}
+
+// RM: smaller period => higher priority. Tie: earlier deadline, then smaller
+// id (the simulators' rule for synchronous releases). Tasks that tie on both
+// period and deadline can be ordered either way without changing feasibility.
+static bool rm_before(const Entry *a, const Entry *b){
+    if (a->t.period != b->t.period) return a->t.period < b->t.period;
+    if (a->t.deadline != b->t.deadline) return a->t.deadline < b->t.deadline;
+    return a->id < b->id;
+}
+
+// Response time of e[i] at level f with e[0..i-1] as higher-priority tasks,
+// iterating up from seed (which must not exceed the fixpoint).
+static bool rta(const Entry *e, int i, int f, uint64_t seed, uint64_t *out){
+    uint64_t r = seed;
+    for (;;){
+        uint64_t nr = e[i].t.wcet[f];
+        for (int k = 0; k < i; ++k) nr += ceil_div(r, e[k].t.period) * e[k].t.wcet[f];
+        if (nr > e[i].t.deadline) return false;
+        if (nr == r){ *out = r; return true; }
+        r = nr;
+    }
+}
+
+static void agg_add(Agg *a, const sched_task *t){
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        double u = (double)t->wcet[f] / t->period;
+        a->U[f] += u;
+        a->S[f] += (double)(t->period - t->deadline) * u;
+    }
+    if (t->deadline < t->period) a->ncons++;
+    if (t->deadline > a->dmax) a->dmax = t->deadline;
+    if (a->dmin == 0 || t->deadline < a->dmin) a->dmin = t->deadline;
+}
+
+// Recomputed from scratch after a removal: no drift from repeated subtraction.
+static void agg_full(Agg *a, const Entry *e, int n){
+    memset(a, 0, sizeof *a);
+    for (int i = 0; i < n; ++i) agg_add(a, &e[i].t);
+}
+
+// Busy-period bound for the processor-demand test; 0 if no finite bound.
+static uint64_t edf_bound(const Agg *a, int f){
+    if (a->U[f] >= 1.0 - U_EPS) return 0;
+    double l = a->S[f] / (1.0 - a->U[f]);
+    if (l > (double)ADM_MAX_BOUND) return 0;
+    uint64_t L = (uint64_t)l + 1;
+    return L > a->dmax ? L : a->dmax;
+}
+
+static uint64_t demand(const Entry *e, int n, int f, uint64_t t){
+    uint64_t h = 0;
+    for (int i = 0; i < n; ++i) h += dbf(&e[i].t, f, t);
+    return h;
+}
+
+// Latest absolute deadline strictly before t (0 if none).
+static uint64_t prev_deadline(const Entry *e, int n, uint64_t t){
+    uint64_t best = 0;
+    for (int i = 0; i < n; ++i){
+        const sched_task *ti = &e[i].t;
+        if (ti->deadline >= t) continue;
+        uint64_t d = ti->deadline + (t - 1 - ti->deadline) / ti->period * ti->period;
+        if (d > best) best = d;
+    }
+    return best;
+}
+
+// EDF processor-demand test at level f. Implicit deadlines need only the
+// utilization; otherwise Quick Processor-demand Analysis (Zhang & Burns)
+// walks down from the last deadline before the busy-period bound, jumping
+// straight to h(t) when h(t) < t. *crit receives the checkpoint with the
+// least slack seen (or the failing one).
+static bool edf_test(const Entry *e, int n, int f, const Agg *a, uint64_t *crit){
+    if (a->U[f] > 1.0 + U_EPS) return false;
+    if (a->ncons == 0) return true;
+    uint64_t L = edf_bound(a, f);
+    if (L == 0) return false;   // U = 1 with constrained deadlines: reject
+
+    uint64_t t = prev_deadline(e, n, L + 1), best_slack = UINT64_MAX;
+    for (;;){
+        uint64_t h = demand(e, n, f, t);
+        if (h > t){ if (crit) *crit = t; return false; }
+        if (crit && t - h < best_slack){ best_slack = t - h; *crit = t; }
+        if (h <= a->dmin) return true;
+        t = (h < t) ? h : prev_deadline(e, n, t);
+    }
+}
+
+bool adm_feasible_full(sched_policy policy, const sched_task *tasks, int n, int level){
+    if (n <= 0) return true;
+    Entry *e = malloc((size_t)n * sizeof *e);
+    if (!e) return false;
+    for (int i = 0; i < n; ++i){
+        e[i].t = tasks[i];
+        e[i].id = i;
+        int k = i;
+        while (policy == SCHED_RM && k > 0 && rm_before(&e[k], &e[k - 1])){
+            Entry tmp = e[k]; e[k] = e[k - 1]; e[k - 1] = tmp;
+            k--;
+        }
+    }
+    bool ok = true;
+    if (policy == SCHED_RM){
+        for (int i = 0; ok && i < n; ++i){
+            uint64_t r;
+            ok = rta(e, i, level, e[i].t.wcet[level], &r);
+        }
+    } else {
+        Agg a;
+        agg_full(&a, e, n);
+        ok = edf_test(e, n, level, &a, NULL);
+    }
+    free(e);
+    return ok;
+}
+
+// ---------- Lifetime ----------
+adm_ctx *adm_create(sched_policy policy){
+    if (policy != SCHED_EDF && policy != SCHED_RM) return NULL;
+    adm_ctx *ctx = calloc(1, sizeof *ctx);
+    if (!ctx) return NULL;
+    ctx->policy = policy;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f) ctx->ok[f] = true;
+    return ctx;
+}
+
+void adm_destroy(adm_ctx *ctx){
+    if (!ctx) return;
+    free(ctx->e);
+    free(ctx);
+}
+
+int adm_num_tasks(const adm_ctx *ctx){
+    return ctx ? ctx->n : 0;
+}
+
+int adm_level(const adm_ctx *ctx){
+    if (!ctx) return SCHED_ERR_INVAL;
+    for (int f = SCHED_NUM_FREQS - 1; f >= 0; --f)
+        if (ctx->ok[f]) return f;
+    return -1;
+}
+
+static void decide(const adm_ctx *ctx, bool admitted, adm_decision *out){
+    if (!out) return;
+    out->admitted = admitted;
+    out->level = adm_level(ctx);
+}
+
+// EDF check of the current set at level f. The tightest checkpoint of the
+// last pass usually stays tight when the set changes, so it is tried first
+// and most rejections cost a single demand evaluation.
+static bool edf_check(adm_ctx *ctx, const Agg *a, int f){
+    if (a->ncons > 0 && ctx->crit[f] > 0 &&
+        demand(ctx->e, ctx->n, f, ctx->crit[f]) > ctx->crit[f]) return false;
+    uint64_t crit = 0;
+    bool ok = edf_test(ctx->e, ctx->n, f, a, &crit);
+    if (crit) ctx->crit[f] = crit;
+    return ok;
+}
+
+// ---------- Changes ----------
+static int find_id(const adm_ctx *ctx, int id){
+    for (int i = 0; i < ctx->n; ++i)
+        if (ctx->e[i].id == id) return i;
+    return -1;
+}
+
+// Inserts task as id; commits if feasible at level 0, otherwise restores
+// the previous state and returns ADM_REJECTED.
+static int insert(adm_ctx *ctx, const sched_task *task, int id){
+    if (ctx->n == ctx->cap){
+        int ncap = ctx->cap ? ctx->cap * 2 : 16;
+        Entry *p = realloc(ctx->e, (size_t)ncap * sizeof *p);
+        if (!p) return SCHED_ERR_NOMEM;
+        ctx->e = p;
+        ctx->cap = ncap;
+    }
+    Entry x;
+    memset(&x, 0, sizeof x);
+    x.t = *task;
+    x.t.name = NULL;
+    if (x.t.deadline == 0) x.t.deadline = x.t.period;
+    x.id = id;
+    int pos = 0;
+    while (pos < ctx->n && rm_before(&ctx->e[pos], &x)) pos++;
+    memmove(&ctx->e[pos + 1], &ctx->e[pos], (size_t)(ctx->n - pos) * sizeof *ctx->e);
+    ctx->e[pos] = x;
+    ctx->n++;
+
+    bool pass[SCHED_NUM_FREQS];
+    Agg a = ctx->agg;
+    if (ctx->policy == SCHED_EDF) agg_add(&a, &x.t);
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        pass[f] = ctx->ok[f];
+        if (!pass[f]) continue;   // adding work never repairs a level
+        if (ctx->policy == SCHED_EDF){
+            pass[f] = edf_check(ctx, &a, f);
+            continue;
+        }
+        uint64_t seed = x.t.wcet[f];
+        pass[f] = rta(ctx->e, pos, f, seed, &ctx->e[pos].Rnew[f]);
+        for (int i = pos + 1; pass[f] && i < ctx->n; ++i)
+            pass[f] = rta(ctx->e, i, f, ctx->e[i].R[f] + x.t.wcet[f], &ctx->e[i].Rnew[f]);
+    }
+
+    if (!pass[0]){
+        ctx->n--;
+        memmove(&ctx->e[pos], &ctx->e[pos + 1], (size_t)(ctx->n - pos) * sizeof *ctx->e);
+        return ADM_REJECTED;
+    }
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        ctx->ok[f] = pass[f];
+        if (pass[f] && ctx->policy == SCHED_RM)
+            for (int i = pos; i < ctx->n; ++i) ctx->e[i].R[f] = ctx->e[i].Rnew[f];
+    }
+    if (ctx->policy == SCHED_EDF) ctx->agg = a;
+    return id;
+}
+
+static void erase(adm_ctx *ctx, int pos){
+    ctx->n--;
+    memmove(&ctx->e[pos], &ctx->e[pos + 1], (size_t)(ctx->n - pos) * sizeof *ctx->e);
+
+    if (ctx->policy == SCHED_RM){
+        for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+            // Lower-priority fixpoints only shrink: restart them from C_i.
+            // A level that was infeasible is re-checked from scratch.
+            int from = ctx->ok[f] ? pos : 0;
+            bool ok = true;
+            for (int i = from; ok && i < ctx->n; ++i)
+                ok = rta(ctx->e, i, f, ctx->e[i].t.wcet[f], &ctx->e[i].R[f]);
+            ctx->ok[f] = ok;
+        }
+        return;
+    }
+
+    agg_full(&ctx->agg, ctx->e, ctx->n);
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f)
+        if (!ctx->ok[f]) ctx->ok[f] = edf_check(ctx, &ctx->agg, f);
+}
+
+static bool valid(const sched_task *t){
+    if (!t || t->period == 0) return false;
+    if (t->deadline > t->period) return false;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f)
+        if (t->wcet[f] == 0) return false;
+    return true;
+}
+
+int adm_add(adm_ctx *ctx, const sched_task *task, adm_decision *out){
+    if (!ctx || !valid(task)) return SCHED_ERR_INVAL;
+    int rc = insert(ctx, task, ctx->next_id);
+    if (rc >= 0) ctx->next_id++;
+    decide(ctx, rc >= 0, out);
+    return rc;
+}
+
+int adm_remove(adm_ctx *ctx, int id, adm_decision *out){
+    if (!ctx) return SCHED_ERR_INVAL;
+    int pos = find_id(ctx, id);
+    if (pos < 0) return SCHED_ERR_INVAL;
+    erase(ctx, pos);
+    decide(ctx, true, out);
+    return SCHED_OK;
+}
+
+int adm_update(adm_ctx *ctx, int id, const sched_task *task, adm_decision *out){
+    if (!ctx || !valid(task)) return SCHED_ERR_INVAL;
+    int pos = find_id(ctx, id);
+    if (pos < 0) return SCHED_ERR_INVAL;
+    sched_task old = ctx->e[pos].t;
+    erase(ctx, pos);
+    int rc = insert(ctx, task, id);
+    if (rc == ADM_REJECTED) insert(ctx, &old, id);   // was feasible before
+    decide(ctx, rc >= 0, out);
+    return rc >= 0 ? SCHED_OK : rc;
+}
@@ -0,0 +1,56 @@
+// admission.h
+// Online admission control for EDF/RM with cached, incrementally updated
+// analysis state. Task parameters and return codes come from sched_lib.h.
+// Build: gcc -O2 -std=c11 -c admission.c
+//
+// Every decision checks the task set at all SCHED_NUM_FREQS levels:
+//   RM:  response-time fixpoints are cached per task and level. Adding a task
+//        leaves higher-priority tasks untouched and restarts lower-priority
+//        ones from their cached fixpoint plus the new WCET.
+//   EDF: utilization and busy-period terms are cached per level, so implicit
+//        deadlines cost O(1). With constrained deadlines the tightest
+//        demand-bound checkpoint of the last pass is cached per level and
+//        tried first; if it holds, Quick Processor-demand Analysis confirms.
+// A task is admitted if the resulting set is schedulable at the fastest
+// level; the decision also reports the slowest level that still works.
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdbool.h>
+#include "sched_lib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADM_REJECTED -10   // the change would make the set unschedulable
+
+typedef struct {
+    bool admitted;
+    int level;        // slowest feasible level after the decision (-1: none)
+} adm_decision;
+
+typedef struct adm_ctx adm_ctx;
+
+adm_ctx *adm_create(sched_policy policy);
+void adm_destroy(adm_ctx *ctx);
+
+// Returns the new task's id (>= 0), ADM_REJECTED or a SCHED_ERR_* code.
+// A rejected task leaves the admitted set unchanged.
+int adm_add(adm_ctx *ctx, const sched_task *task, adm_decision *out);
+int adm_remove(adm_ctx *ctx, int id, adm_decision *out);
+// Re-parameterizes task id; on rejection the old parameters stay in place.
+int adm_update(adm_ctx *ctx, int id, const sched_task *task, adm_decision *out);
+
+int adm_num_tasks(const adm_ctx *ctx);
+int adm_level(const adm_ctx *ctx);   // slowest feasible level, -1 if none
+
+// From-scratch analysis of a task set at one level (reference / slow path).
+bool adm_feasible_full(sched_policy policy, const sched_task *tasks, int n, int level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADMISSION_H
@@ -0,0 +1,170 @@
+// admission_bench.c
+// Decision latency of incremental admission control vs. from-scratch analysis.
+// Build: gcc -O2 -std=c11 admission_bench.c admission.c -o admission_bench
+// Run:   ./admission_bench [edf|rm] [operations] [seed]
+//
+// Drives a random mix of add / remove / re-parameterize requests through
+// admission.c, times every decision with clock_gettime, checks each one
+// against adm_feasible_full, and prints latency percentiles for both.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "admission.h"
+
+#define MAX_LIVE 256
+
+static uint64_t rng_state;
+
+static uint32_t rng(void){
+    // xorshift64*
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (uint32_t)((rng_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static uint64_t now_ns(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// WCETs scale like test_input.txt: slower levels take proportionally longer.
+static sched_task random_task(void){
+    static const double ratio[SCHED_NUM_FREQS] = {1.0, 1.29, 1.77, 3.0};
+    sched_task t = {0};
+    t.period = 50 + rng() % 2000;
+    t.deadline = (rng() % 4 == 0) ? t.period / 2 + rng() % (t.period / 2) : t.period;
+    uint32_t c = 1 + rng() % (t.period / 20 + 1);
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        t.wcet[f] = (uint32_t)(c * ratio[f] + 0.5);
+        if (t.wcet[f] > t.deadline) t.wcet[f] = t.deadline;
+    }
+    return t;
+}
+
+static int cmp_u64(const void *a, const void *b){
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char *label, uint64_t *ns, int n){
+    if (n == 0) return;
+    qsort(ns, (size_t)n, sizeof *ns, cmp_u64);
+    printf("%-12s n=%-7d p50=%7.2fus  p90=%7.2fus  p99=%7.2fus  p99.9=%7.2fus  max=%8.2fus\n",
+           label, n, ns[n / 2] / 1e3, ns[n * 9 / 10] / 1e3, ns[n * 99 / 100] / 1e3,
+           ns[(int)(n * 0.999)] / 1e3, ns[n - 1] / 1e3);
+}
+
+int main(int argc, char **argv){
+    sched_policy pol = SCHED_EDF;
+    if (argc >= 2){
+        if (strcmp(argv[1], "edf") == 0) pol = SCHED_EDF;
+        else if (strcmp(argv[1], "rm") == 0) pol = SCHED_RM;
+        else {
+            fprintf(stderr, "Usage: %s [edf|rm] [operations] [seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    int ops = (argc >= 3) ? atoi(argv[2]) : 20000;
+    rng_state = (argc >= 4) ? strtoull(argv[3], NULL, 10) : 88172645463325252ULL;
+    if (ops <= 0 || rng_state == 0){
+        fprintf(stderr, "operations and seed must be positive\n");
+        return 1;
+    }
+
+    adm_ctx *adm = adm_create(pol);
+    uint64_t *inc_ns = malloc((size_t)ops * sizeof *inc_ns);
+    uint64_t *full_ns = malloc((size_t)ops * sizeof *full_ns);
+    if (!adm || !inc_ns || !full_ns){
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    // Shadow copy of the admitted set for the from-scratch check.
+    sched_task live[MAX_LIVE], trial[MAX_LIVE];
+    int live_id[MAX_LIVE], nlive = 0;
+    int admitted = 0, rejected = 0, mismatches = 0;
+
+    for (int op = 0; op < ops; ++op){
+        int kind = rng() % 10;   // 60% add, 20% remove, 20% update
+        if (nlive == 0) kind = 0;
+        if (nlive == MAX_LIVE && kind < 6) kind = 6;
+        adm_decision d;
+        uint64_t t0, t1;
+        int slot = -1;
+        sched_task t = random_task();
+
+        if (kind < 6){
+            t0 = now_ns();
+            int id = adm_add(adm, &t, &d);
+            t1 = now_ns();
+            if (id >= 0){
+                live[nlive] = t;
+                live_id[nlive++] = id;
+            }
+        } else if (kind < 8){
+            slot = rng() % nlive;
+            t0 = now_ns();
+            adm_remove(adm, live_id[slot], &d);
+            t1 = now_ns();
+            live[slot] = live[--nlive];
+            live_id[slot] = live_id[nlive];
+        } else {
+            slot = rng() % nlive;
+            t0 = now_ns();
+            adm_update(adm, live_id[slot], &t, &d);
+            t1 = now_ns();
+        }
+        inc_ns[op] = t1 - t0;
+        if (d.admitted) admitted++; else rejected++;
+
+        // Reference: the same decision from scratch.
+        int n = nlive;
+        memcpy(trial, live, (size_t)nlive * sizeof *trial);
+        if (kind < 6 && !d.admitted) trial[n++] = t;
+        if (kind >= 8) trial[slot] = t;
+        // WCETs never shrink at slower levels, so any feasible level implies
+        // level 0 is feasible: the scan alone answers the admission question.
+        uint64_t f0 = now_ns();
+        int level = -1;
+        for (int f = SCHED_NUM_FREQS - 1; f >= 0 && level < 0; --f)
+            if (adm_feasible_full(pol, trial, n, f)) level = f;
+        bool want = level >= 0;
+        full_ns[op] = now_ns() - f0;
+        if (kind >= 8 && d.admitted) live[slot] = t;
+
+        bool expect_admit = (kind >= 6 && kind < 8) || want;
+        int expect_level = level;
+        if (!expect_admit){
+            // Rejected: the level is that of the unchanged set.
+            expect_level = -1;
+            if (kind >= 8) trial[slot] = live[slot];
+            else n--;
+            for (int f = SCHED_NUM_FREQS - 1; f >= 0 && expect_level < 0; --f)
+                if (adm_feasible_full(pol, trial, n, f)) expect_level = f;
+        }
+        if (d.admitted != expect_admit || d.level != expect_level){
+            if (mismatches++ < 5)
+                fprintf(stderr, "op %d: incremental admit=%d level=%d, full admit=%d level=%d\n",
+                        op, d.admitted, d.level, expect_admit, expect_level);
+        }
+    }
+
+    printf("=== Admission control (%s): %d operations, %d accepted, %d rejected, "
+           "%d tasks admitted at end ===\n",
+           pol == SCHED_EDF ? "EDF" : "RM", ops, admitted, rejected, adm_num_tasks(adm));
+    report("incremental", inc_ns, ops);
+    report("from scratch", full_ns, ops);
+    printf("Mismatches vs. from-scratch analysis: %d\n", mismatches);
+
+    free(inc_ns);
+    free(full_ns);
+    adm_destroy(adm);
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,508 @@
+// dag.c
+// Parallel (DAG) tasks on m identical cores: each periodic task is a graph
+// of nodes with precedence edges, analysed and simulated under federated
+// and global EDF scheduling.
+// Build: gcc -O2 -std=c11 dag.c -o dag
+// Run:   ./dag [input_file] [--cores m] [--freq 0-3] [--end T]
+//
+// Input (default dag_input.txt):
+//   numDags cores T_end
+//   then per DAG:  name period deadline numNodes numEdges   (deadline <= period)
+//   per node:      name wcet1188 wcet918 wcet648 wcet384
+//   per edge:      from to                                  (node names)
+//
+// Metrics: volume C (sum of node WCETs), critical path L (longest chain),
+// utilization C/T and density C/D.
+//
+// Federated scheduling (Li et al.): a DAG with C > D is heavy and gets
+// n = ceil((C - L) / (D - L)) dedicated cores, on which any greedy
+// scheduler finishes within L + (C - L) / n <= D. Light DAGs run as
+// sequential tasks of length C; they are packed first-fit by decreasing
+// density onto the remaining cores, each running EDF, with a density sum of
+// at most 1 per core.
+//
+// Global EDF: all ready nodes of all DAGs share the m cores, ordered by the
+// absolute deadline of their DAG instance. The capacity augmentation bound
+// b = 4 - 2/m gives a sufficient test for implicit deadlines: sum C/T <= m/b
+// and L <= D/b for every DAG.
+//
+// In the simulation a node becomes ready once its last predecessor has
+// completed: every instance keeps a count of unfinished predecessors per
+// node, and a completion decrements the counts of its successors (stored
+// contiguously per node), so releasing work costs time proportional to the
+// out-degree rather than a rescan of the graph. As in EDF.cpp, an instance
+// that is still unfinished after its deadline is dropped.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MAX_DAGS   16
+#define MAX_NODES  32          // per DAG
+#define MAX_EDGES  256         // per DAG
+#define MAX_CORES  64
+#define MAX_ACTIVE 2           // instances of one DAG alive at once (D <= T)
+#define NUM_FREQS  4
+#define READY_QUEUE_SIZE (MAX_DAGS * MAX_ACTIVE * MAX_NODES)
+
+static const int FREQUENCIES[NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    char name[32];
+    uint32_t wcet[NUM_FREQS];
+} Node;
+
+typedef struct {
+    char name[32];
+    uint32_t period, deadline;
+    int n, num_edges;
+    Node nodes[MAX_NODES];
+    int indeg[MAX_NODES];
+    int succ_start[MAX_NODES + 1];   // successors of v: succ[succ_start[v] .. succ_start[v + 1])
+    int succ[MAX_EDGES];
+
+    uint64_t volume, cpath;          // at the selected level
+    int dedicated;                   // federated: cores of a heavy DAG, 0 if light
+    int domain;                      // scheduling domain in the current run
+} Dag;
+
+// One released job of a DAG
+typedef struct {
+    bool active;
+    uint64_t release, abs_deadline, seq;
+    int pending[MAX_NODES];          // predecessors not yet complete
+    uint32_t remaining[MAX_NODES];
+    int core[MAX_NODES];             // core the node last ran on, -1: none
+    int done;                        // completed nodes
+} Instance;
+
+typedef struct { int dag, slot, node; } NodeRef;
+
+// A set of cores and the DAGs scheduled on them by EDF
+typedef struct { int first_core, cores; } Domain;
+
+typedef struct { uint64_t released, completed, misses, max_response; } DagResult;
+
+static Dag dags[MAX_DAGS];
+static int num_dags, num_cores, level;
+static Domain domains[MAX_CORES + MAX_DAGS];
+static int num_domains;
+
+// Simulation state
+static Instance inst[MAX_DAGS][MAX_ACTIVE];
+static uint64_t next_seq[MAX_DAGS];
+static NodeRef ready[READY_QUEUE_SIZE];
+static int ready_count;
+static int core_owner[MAX_CORES];    // node that ran there in the last tick, -1: none
+static DagResult results[MAX_DAGS];
+static uint64_t preemptions, migrations, busy_ticks;
+
+// ---------- Input ----------
+static int node_index(const Dag *d, const char *name){
+    for (int v = 0; v < d->n; ++v) if (strcmp(d->nodes[v].name, name) == 0) return v;
+    return -1;
+}
+
+static bool load_dag(FILE *f, Dag *d){
+    if (fscanf(f, "%31s %u %u %d %d", d->name, &d->period, &d->deadline, &d->n,
+               &d->num_edges) != 5 ||
+        d->period == 0 || d->deadline == 0 || d->deadline > d->period ||
+        d->n <= 0 || d->n > MAX_NODES || d->num_edges < 0 || d->num_edges > MAX_EDGES)
+        return false;
+    for (int v = 0; v < d->n; ++v){
+        Node *x = &d->nodes[v];
+        if (fscanf(f, "%31s %u %u %u %u", x->name, &x->wcet[0], &x->wcet[1], &x->wcet[2],
+                   &x->wcet[3]) != 5 ||
+            x->wcet[0] == 0 || x->wcet[1] == 0 || x->wcet[2] == 0 || x->wcet[3] == 0)
+            return false;
+    }
+    int from[MAX_EDGES], to[MAX_EDGES], outdeg[MAX_NODES] = { 0 };
+    for (int e = 0; e < d->num_edges; ++e){
+        char a[32], b[32];
+        if (fscanf(f, "%31s %31s", a, b) != 2) return false;
+        from[e] = node_index(d, a);
+        to[e] = node_index(d, b);
+        if (from[e] < 0 || to[e] < 0){
+            fprintf(stderr, "Unknown node in edge %s -> %s of %s\n", a, b, d->name);
+            return false;
+        }
+        outdeg[from[e]]++;
+        d->indeg[to[e]]++;
+    }
+    // Successor lists, contiguous per node
+    d->succ_start[0] = 0;
+    for (int v = 0; v < d->n; ++v) d->succ_start[v + 1] = d->succ_start[v] + outdeg[v];
+    int fill[MAX_NODES];
+    memcpy(fill, d->succ_start, sizeof(int) * d->n);
+    for (int e = 0; e < d->num_edges; ++e) d->succ[fill[from[e]]++] = to[e];
+    return true;
+}
+
+static bool load_input(const char *path, uint64_t *t_end){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    unsigned long long end;
+    bool ok = fscanf(f, "%d %d %llu", &num_dags, &num_cores, &end) == 3 &&
+              num_dags > 0 && num_dags <= MAX_DAGS;
+    for (int i = 0; ok && i < num_dags; ++i) ok = load_dag(f, &dags[i]);
+    fclose(f);
+    *t_end = end;
+    return ok;
+}
+
+// ---------- Metrics ----------
+// Volume and critical path at the current level; false if the graph has a
+// cycle. Kahn's algorithm, with the longest path carried along.
+static bool dag_metrics(Dag *d){
+    int indeg[MAX_NODES], queue[MAX_NODES], head = 0, tail = 0;
+    uint64_t finish[MAX_NODES];
+    memcpy(indeg, d->indeg, sizeof(int) * d->n);
+    d->volume = d->cpath = 0;
+    for (int v = 0; v < d->n; ++v){
+        finish[v] = d->nodes[v].wcet[level];
+        d->volume += d->nodes[v].wcet[level];
+        if (indeg[v] == 0) queue[tail++] = v;
+    }
+    while (head < tail){
+        int v = queue[head++];
+        if (finish[v] > d->cpath) d->cpath = finish[v];
+        for (int e = d->succ_start[v]; e < d->succ_start[v + 1]; ++e){
+            int s = d->succ[e];
+            uint64_t f = finish[v] + d->nodes[s].wcet[level];
+            if (f > finish[s]) finish[s] = f;
+            if (--indeg[s] == 0) queue[tail++] = s;
+        }
+    }
+    return tail == d->n;
+}
+
+// ---------- Federated allocation ----------
+// Returns false if the DAGs do not fit on num_cores; sets up the domains.
+static bool federated_assign(void){
+    num_domains = 0;
+    int core = 0;
+    for (int i = 0; i < num_dags; ++i){
+        Dag *d = &dags[i];
+        d->dedicated = 0;
+        if (d->volume <= d->deadline) continue;
+        if (d->cpath >= d->deadline) return false;
+        d->dedicated = (int)((d->volume - d->cpath + (d->deadline - d->cpath) - 1) /
+                             (d->deadline - d->cpath));
+        if (core + d->dedicated > num_cores) return false;
+        domains[num_domains] = (Domain){ core, d->dedicated };
+        d->domain = num_domains++;
+        core += d->dedicated;
+    }
+
+    // Light DAGs: first fit by decreasing density
+    int order[MAX_DAGS], nl = 0;
+    for (int i = 0; i < num_dags; ++i) if (!dags[i].dedicated) order[nl++] = i;
+    for (int a = 1; a < nl; ++a){
+        int x = order[a], b = a;
+        double dx = (double)dags[x].volume / dags[x].deadline;
+        for (; b > 0 && (double)dags[order[b - 1]].volume / dags[order[b - 1]].deadline < dx; --b)
+            order[b] = order[b - 1];
+        order[b] = x;
+    }
+    int first_shared = num_domains;
+    double load[MAX_CORES] = { 0 };
+    for (int a = 0; a < nl; ++a){
+        Dag *d = &dags[order[a]];
+        double dens = (double)d->volume / d->deadline;
+        int s = first_shared;
+        while (s < num_domains && load[s - first_shared] + dens > 1.0 + 1e-12) s++;
+        if (s == num_domains){
+            if (core >= num_cores) return false;
+            domains[num_domains++] = (Domain){ core++, 1 };
+        }
+        load[s - first_shared] += dens;
+        d->domain = s;
+    }
+    return true;
+}
+
+static void global_assign(void){
+    num_domains = 1;
+    domains[0] = (Domain){ 0, num_cores };
+    for (int i = 0; i < num_dags; ++i) dags[i].domain = 0;
+}
+
+// ---------- Simulation ----------
+static int ref_code(NodeRef r){ return (r.dag * MAX_ACTIVE + r.slot) * MAX_NODES + r.node; }
+
+static void rq_push(NodeRef r){
+    if (ready_count < READY_QUEUE_SIZE) {
+        ready[ready_count++] = r;
+    } else {
+        fprintf(stderr, "Ready queue full; dropping node!\n");
+    }
+}
+
+// EDF on the instance deadline; ties by DAG, instance, node.
+static bool ref_before(NodeRef a, NodeRef b){
+    const Instance *x = &inst[a.dag][a.slot], *y = &inst[b.dag][b.slot];
+    if (x->abs_deadline != y->abs_deadline) return x->abs_deadline < y->abs_deadline;
+    if (a.dag != b.dag) return a.dag < b.dag;
+    if (x->seq != y->seq) return x->seq < y->seq;
+    return a.node < b.node;
+}
+
+static void release_and_drop(uint64_t t){
+    for (int i = 0; i < num_dags; ++i){
+        const Dag *d = &dags[i];
+        if (t % d->period == 0){
+            int s = 0;
+            while (s < MAX_ACTIVE && inst[i][s].active) s++;
+            if (s == MAX_ACTIVE){
+                fprintf(stderr, "Too many live instances of %s; dropping release!\n", d->name);
+                continue;
+            }
+            Instance *x = &inst[i][s];
+            x->active = true;
+            x->release = t;
+            x->abs_deadline = t + d->deadline;
+            x->seq = next_seq[i]++;
+            x->done = 0;
+            for (int v = 0; v < d->n; ++v){
+                x->pending[v] = d->indeg[v];
+                x->remaining[v] = d->nodes[v].wcet[level];
+                x->core[v] = -1;
+                if (d->indeg[v] == 0) rq_push((NodeRef){ i, s, v });
+            }
+            results[i].released++;
+        }
+        for (int s = 0; s < MAX_ACTIVE; ++s){
+            Instance *x = &inst[i][s];
+            if (x->active && t > x->abs_deadline){
+                results[i].misses++;
+                x->active = false;
+            }
+        }
+    }
+    // Forget the ready nodes of dropped instances
+    int w = 0;
+    for (int r = 0; r < ready_count; ++r)
+        if (inst[ready[r].dag][ready[r].slot].active) ready[w++] = ready[r];
+    ready_count = w;
+}
+
+// Completes node r at the end of tick t, readying successors whose last
+// predecessor it was.
+static void complete_node(NodeRef r, uint64_t t){
+    const Dag *d = &dags[r.dag];
+    Instance *x = &inst[r.dag][r.slot];
+    for (int e = d->succ_start[r.node]; e < d->succ_start[r.node + 1]; ++e){
+        int s = d->succ[e];
+        if (--x->pending[s] == 0) rq_push((NodeRef){ r.dag, r.slot, s });
+    }
+    if (++x->done == d->n){
+        DagResult *res = &results[r.dag];
+        res->completed++;
+        if (t + 1 - x->release > res->max_response) res->max_response = t + 1 - x->release;
+        x->active = false;
+    }
+}
+
+// One tick of domain dm: the `cores` most urgent ready nodes run. A node
+// that ran in the last tick keeps its core.
+static void run_domain(int dm, uint64_t t, int *prev_owner){
+    const Domain *dom = &domains[dm];
+    int pick[MAX_CORES], np = 0;   // ready indices, most urgent first
+    for (int r = 0; r < ready_count; ++r){
+        if (dags[ready[r].dag].domain != dm) continue;
+        int p = (np < dom->cores) ? np++ : np;
+        if (p == dom->cores && !ref_before(ready[r], ready[pick[p - 1]])) continue;
+        if (p == dom->cores) p--;
+        while (p > 0 && ref_before(ready[r], ready[pick[p - 1]])){
+            pick[p] = pick[p - 1];
+            p--;
+        }
+        pick[p] = r;
+    }
+
+    int slot_of[MAX_CORES];        // chosen core per pick
+    bool taken[MAX_CORES] = { false };
+    for (int k = 0; k < np; ++k){
+        const NodeRef *r = &ready[pick[k]];
+        int c = inst[r->dag][r->slot].core[r->node];
+        slot_of[k] = -1;
+        if (c >= 0 && prev_owner[c] == ref_code(*r)){
+            slot_of[k] = c;
+            taken[c - dom->first_core] = true;
+        }
+    }
+    // Nodes that ran last tick and were not picked are preempted
+    for (int c = dom->first_core; c < dom->first_core + dom->cores; ++c){
+        if (prev_owner[c] >= 0 && !taken[c - dom->first_core]) preemptions++;
+        core_owner[c] = -1;
+    }
+    int next_free = 0;
+    for (int k = 0; k < np; ++k){
+        NodeRef r = ready[pick[k]];
+        Instance *x = &inst[r.dag][r.slot];
+        int c = slot_of[k];
+        if (c < 0){
+            while (taken[next_free]) next_free++;
+            taken[next_free] = true;
+            c = dom->first_core + next_free;
+            if (x->core[r.node] >= 0 && x->core[r.node] != c) migrations++;
+            x->core[r.node] = c;
+        }
+        busy_ticks++;
+        if (--x->remaining[r.node] == 0) complete_node(r, t);
+        else core_owner[c] = ref_code(r);
+    }
+}
+
+static void simulate(uint64_t end){
+    memset(inst, 0, sizeof inst);
+    memset(next_seq, 0, sizeof next_seq);
+    memset(results, 0, sizeof results);
+    ready_count = 0;
+    preemptions = migrations = busy_ticks = 0;
+    for (int c = 0; c < MAX_CORES; ++c) core_owner[c] = -1;
+
+    int prev_owner[MAX_CORES];
+    for (uint64_t t = 0; t <= end; ++t){
+        release_and_drop(t);
+        // Preempted nodes of dropped instances no longer count
+        for (int c = 0; c < num_cores; ++c){
+            int o = core_owner[c];
+            prev_owner[c] = (o >= 0 && inst[o / MAX_NODES / MAX_ACTIVE][o / MAX_NODES % MAX_ACTIVE].active)
+                          ? o : -1;
+        }
+        int ready_before = ready_count;
+        for (int dm = 0; dm < num_domains; ++dm) run_domain(dm, t, prev_owner);
+        // Drop completed nodes; successors pushed this tick stay
+        int w = 0;
+        for (int r = 0; r < ready_count; ++r){
+            const NodeRef *x = &ready[r];
+            const Instance *in = &inst[x->dag][x->slot];
+            if (r >= ready_before || (in->active && in->remaining[x->node] > 0)) ready[w++] = *x;
+        }
+        ready_count = w;
+    }
+}
+
+static void print_results(const char *label, uint64_t end){
+    printf("%s:\n", label);
+    uint64_t misses = 0;
+    for (int i = 0; i < num_dags; ++i){
+        const DagResult *r = &results[i];
+        printf("  %-10s Released=%llu, Completed=%llu, Misses=%llu, Max response=%llu (D=%u)\n",
+               dags[i].name, (unsigned long long)r->released, (unsigned long long)r->completed,
+               (unsigned long long)r->misses, (unsigned long long)r->max_response,
+               dags[i].deadline);
+        misses += r->misses;
+    }
+    uint64_t capacity = (end + 1) * (uint64_t)num_cores;
+    printf("  Total misses=%llu, Preemptions=%llu, Migrations=%llu, Core utilization=%.2f%%\n",
+           (unsigned long long)misses, (unsigned long long)preemptions,
+           (unsigned long long)migrations, 100.0 * busy_ticks / capacity);
+}
+
+int main(int argc, char **argv){
+    const char *input = "dag_input.txt";
+    uint64_t end = 0, t_end = 0;
+    int cores = 0;
+    int k = 1;
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--cores") == 0 && k + 1 < argc){
+            cores = atoi(argv[++k]);
+            if (cores < 1 || cores > MAX_CORES) break;
+        } else if (strcmp(argv[k], "--freq") == 0 && k + 1 < argc){
+            level = atoi(argv[++k]);
+            if (level < 0 || level >= NUM_FREQS) break;
+        } else if (strcmp(argv[k], "--end") == 0 && k + 1 < argc){
+            end = strtoull(argv[++k], NULL, 10);
+        } else {
+            break;
+        }
+    }
+    if (k < argc){
+        fprintf(stderr, "Usage: %s [input_file] [--cores m] [--freq 0-3] [--end T]\n", argv[0]);
+        return 1;
+    }
+    if (!load_input(input, &t_end)){
+        fprintf(stderr, "Cannot read DAG tasks from %s\n", input);
+        return 1;
+    }
+    if (cores) num_cores = cores;
+    if (num_cores < 1 || num_cores > MAX_CORES){
+        fprintf(stderr, "Core count must be 1..%d\n", MAX_CORES);
+        return 1;
+    }
+    if (end) t_end = end;
+
+    printf("=== DAG tasks @ %d MHz on %d cores ===\n", FREQUENCIES[level], num_cores);
+    printf("  %-10s %5s %5s %7s %8s %8s %9s %7s %8s\n", "name", "nodes", "edges", "period",
+           "deadline", "volume", "crit.path", "util", "density");
+    double total_u = 0.0;
+    bool implicit = true, paths_fit = true;
+    for (int i = 0; i < num_dags; ++i){
+        Dag *d = &dags[i];
+        if (!dag_metrics(d)){
+            fprintf(stderr, "%s has a cycle\n", d->name);
+            return 1;
+        }
+        double u = (double)d->volume / d->period;
+        total_u += u;
+        implicit = implicit && d->deadline == d->period;
+        paths_fit = paths_fit && d->cpath <= d->deadline;
+        printf("  %-10s %5d %5d %7u %8u %8llu %9llu %7.3f %8.3f\n", d->name, d->n, d->num_edges,
+               d->period, d->deadline, (unsigned long long)d->volume,
+               (unsigned long long)d->cpath, u, (double)d->volume / d->deadline);
+    }
+    printf("  Total utilization=%.3f%s\n", total_u,
+           paths_fit ? "" : "  (a critical path exceeds its deadline: infeasible)");
+
+    printf("\n=== Federated scheduling ===\n");
+    bool fed_ok = federated_assign();
+    if (fed_ok){
+        int used = 0;
+        for (int dm = 0; dm < num_domains; ++dm) used += domains[dm].cores;
+        for (int i = 0; i < num_dags; ++i){
+            const Dag *d = &dags[i];
+            const Domain *dom = &domains[d->domain];
+            if (d->dedicated)
+                printf("  %-10s heavy: cores %d-%d, response bound L + (C-L)/n = %.1f\n", d->name,
+                       dom->first_core, dom->first_core + dom->cores - 1,
+                       d->cpath + (double)(d->volume - d->cpath) / d->dedicated);
+            else
+                printf("  %-10s light: core %d (sequential, density %.3f)\n", d->name,
+                       dom->first_core, (double)d->volume / d->deadline);
+        }
+        printf("  Cores used: %d of %d: schedulable\n", used, num_cores);
+    } else {
+        printf("  NOT schedulable: the DAGs need more than %d cores\n", num_cores);
+    }
+
+    double b = 4.0 - 2.0 / num_cores;
+    printf("\n=== Global EDF (capacity augmentation bound b = %.3f) ===\n", b);
+    if (implicit){
+        double max_ratio = 0.0;
+        for (int i = 0; i < num_dags; ++i){
+            double r = (double)dags[i].cpath / dags[i].deadline;
+            if (r > max_ratio) max_ratio = r;
+        }
+        bool ok = total_u <= num_cores / b && max_ratio <= 1.0 / b;
+        printf("  sum C/T = %.3f (<= m/b = %.3f), max L/D = %.3f (<= 1/b = %.3f): %s\n", total_u,
+               num_cores / b, max_ratio, 1.0 / b, ok ? "schedulable" : "not guaranteed");
+    } else {
+        printf("  The bound covers implicit deadlines only; see the simulation\n");
+    }
+
+    printf("\n=== Simulation, t <= %llu ===\n", (unsigned long long)t_end);
+    if (fed_ok){
+        simulate(t_end);
+        print_results("Federated", t_end);
+    }
+    global_assign();
+    simulate(t_end);
+    print_results("Global EDF", t_end);
+    return 0;
+}
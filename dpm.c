@@ -0,0 +1,210 @@
+// dpm.c
+// Dynamic power management report: sleep states and procrastination
+// combined with every DVFS choice, on top of libsched.
+// Build: gcc -O2 -std=c11 dpm.c sched_lib.c sched_cache.c -o dpm -lm
+// Run:   ./dpm [edf|rm] [input_file] [--states FILE] [--end T] [--cache FILE]
+//
+// Sleep states are read from FILE, one per line:
+//   name power wake_latency break_even
+// (power in the units of test_input.txt, times in ticks). Without --states
+// a three-state table below the 384 MHz idle figure is used.
+//
+// For each DVFS choice (fixed 1188/918/648/384 MHz, and the static EE
+// level) the task set runs without DPM, with greedy DPM and with
+// procrastination. The cheapest run without misses is then broken down
+// into time and energy per state. With --cache, runs whose configuration
+// was simulated before (by any process sharing FILE) are not repeated.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_lib.h"
+#include "sched_cache.h"
+
+#define NUM_CHOICES (SCHED_NUM_FREQS + 1)   // fixed levels, then EE
+#define NUM_MODES   3
+
+static const int FREQUENCIES[SCHED_NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+static const char *MODE_NAMES[NUM_MODES] = { "no DPM", "greedy", "procrastinate" };
+
+static char state_names[SCHED_MAX_SLEEP][32] = { "standby", "retention", "off" };
+static sched_sleep_state states[SCHED_MAX_SLEEP] = {
+    { 30.0,  1,   3 },
+    {  8.0,  5,  20 },
+    {  1.0, 30, 120 },
+};
+static int num_states = 3;
+
+static sched_cache *cache;             // NULL: always simulate
+static int cache_hits, cache_misses;
+
+static bool load_states(const char *path){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    num_states = 0;
+    char name[32];
+    double power;
+    unsigned lat, be;
+    while (num_states < SCHED_MAX_SLEEP &&
+           fscanf(f, "%31s %lf %u %u", name, &power, &lat, &be) == 4){
+        strcpy(state_names[num_states], name);
+        states[num_states].power = power;
+        states[num_states].wake_latency = lat;
+        states[num_states].break_even = be;
+        num_states++;
+    }
+    fclose(f);
+    return num_states > 0;
+}
+
+static double total_energy(const sched_stats *st){
+    double e = st->energy_busy + st->energy_idle + st->energy_wake;
+    for (int s = 0; s < num_states; ++s) e += st->energy_sleep[s];
+    return e;
+}
+
+static int run(sched_policy pol, const char *input, uint64_t end, int choice, int mode,
+               sched_stats *st, int *level){
+    sched_ctx *ctx = sched_create(pol, NULL);
+    uint64_t t_end = 0;
+    int rc = ctx ? sched_load_input(ctx, input, &t_end) : SCHED_ERR_NOMEM;
+    if (rc == SCHED_OK){
+        if (end) t_end = end;
+        if (choice < SCHED_NUM_FREQS) sched_set_freq(ctx, SCHED_FREQ_FIXED, choice);
+        else sched_set_freq(ctx, SCHED_FREQ_EE, 0);
+        sched_set_dpm(ctx, (sched_dpm_mode)mode, states, mode == SCHED_DPM_OFF ? 0 : num_states);
+        uint64_t key[2];
+        bool keyed = cache && sched_config_hash(ctx, t_end, key) == SCHED_OK;
+        if (keyed && sched_cache_get(cache, key, st)){
+            cache_hits++;
+            sched_step(ctx);   // one tick settles the frequency level
+        } else {
+            rc = sched_run_until(ctx, t_end);
+            sched_get_stats(ctx, st);
+            if (keyed && rc == SCHED_OK) sched_cache_put(cache, key, st);
+            cache_misses += keyed;
+        }
+        *level = sched_current_freq(ctx);
+    }
+    sched_destroy(ctx);
+    return rc;
+}
+
+static void breakdown(const char *input, const sched_stats *st){
+    double power[SCHED_NUM_FREQS], idle;
+    sched_ctx *ctx = sched_create(SCHED_EDF, NULL);
+    sched_load_input(ctx, input, NULL);
+    sched_get_power(ctx, power, &idle);
+    sched_destroy(ctx);
+
+    double total = total_energy(st);
+    uint64_t ticks = st->busy_ticks + st->idle_ticks;
+    uint64_t awake_idle = st->idle_ticks - st->wake_ticks;
+    for (int s = 0; s < num_states; ++s) awake_idle -= st->sleep_ticks[s];
+
+    printf("  %-16s %10s %7s %12s %7s %8s\n", "state", "ticks", "time%", "energy", "energy%", "entries");
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        if (!st->freq_ticks[f]) continue;
+        char label[32];
+        snprintf(label, sizeof label, "active %d MHz", FREQUENCIES[f]);
+        double e = st->freq_ticks[f] * power[f];
+        printf("  %-16s %10llu %6.2f%% %12.2f %6.2f%%\n", label,
+               (unsigned long long)st->freq_ticks[f], 100.0 * st->freq_ticks[f] / ticks,
+               e, 100.0 * e / total);
+    }
+    printf("  %-16s %10llu %6.2f%% %12.2f %6.2f%%\n", "idle (awake)",
+           (unsigned long long)awake_idle, 100.0 * awake_idle / ticks,
+           st->energy_idle, 100.0 * st->energy_idle / total);
+    for (int s = 0; s < num_states; ++s){
+        printf("  %-16s %10llu %6.2f%% %12.2f %6.2f%% %8llu\n", state_names[s],
+               (unsigned long long)st->sleep_ticks[s], 100.0 * st->sleep_ticks[s] / ticks,
+               st->energy_sleep[s], 100.0 * st->energy_sleep[s] / total,
+               (unsigned long long)st->sleep_entries[s]);
+    }
+    printf("  %-16s %10llu %6.2f%% %12.2f %6.2f%%\n", "wake-up",
+           (unsigned long long)st->wake_ticks, 100.0 * st->wake_ticks / ticks,
+           st->energy_wake, 100.0 * st->energy_wake / total);
+}
+
+int main(int argc, char **argv){
+    sched_policy pol = SCHED_EDF;
+    const char *input = "test_input.txt";
+    uint64_t end = 0;
+    int k = 1;
+    if (k < argc && (strcmp(argv[k], "edf") == 0 || strcmp(argv[k], "rm") == 0)){
+        pol = (strcmp(argv[k], "edf") == 0) ? SCHED_EDF : SCHED_RM;
+        k++;
+    }
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--states") == 0 && k + 1 < argc){
+            if (!load_states(argv[++k])){
+                fprintf(stderr, "Cannot read sleep states from %s\n", argv[k]);
+                return 1;
+            }
+        } else if (strcmp(argv[k], "--end") == 0 && k + 1 < argc){
+            end = strtoull(argv[++k], NULL, 10);
+        } else if (strcmp(argv[k], "--cache") == 0 && k + 1 < argc){
+            cache = sched_cache_open(argv[++k], 0);
+            if (!cache){
+                fprintf(stderr, "Cannot open result cache %s\n", argv[k]);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Usage: %s [edf|rm] [input_file] [--states FILE] [--end T] [--cache FILE]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+
+    printf("Sleep states:\n");
+    for (int s = 0; s < num_states; ++s)
+        printf("  %-12s power=%.2f  wake latency=%u  break-even=%u\n", state_names[s],
+               states[s].power, states[s].wake_latency, states[s].break_even);
+
+    printf("\n=== %s: energy by DVFS choice and DPM mode ===\n", pol == SCHED_EDF ? "EDF" : "RM");
+    printf("  %-14s %-14s %6s %8s %12s\n", "DVFS", "DPM", "delay", "misses", "energy");
+    sched_stats best_st;
+    char best_label[32] = "";
+    int best_choice = -1, best_mode = -1;
+    double best_energy = 0.0;
+    for (int c = 0; c < NUM_CHOICES; ++c){
+        for (int m = 0; m < NUM_MODES; ++m){
+            sched_stats st;
+            int level;
+            int rc = run(pol, input, end, c, m, &st, &level);
+            if (rc != SCHED_OK){
+                fprintf(stderr, "Cannot run %s: %s\n", input, sched_strerror(rc));
+                return 1;
+            }
+            char label[32];
+            if (c < SCHED_NUM_FREQS) snprintf(label, sizeof label, "%d MHz", FREQUENCIES[c]);
+            else snprintf(label, sizeof label, "EE (%d MHz)", FREQUENCIES[level]);
+            double e = total_energy(&st);
+            printf("  %-14s %-14s %6llu %8llu %12.2f\n", label, MODE_NAMES[m],
+                   (unsigned long long)st.dpm_delay, (unsigned long long)st.misses, e);
+            if (st.misses == 0 && (best_choice < 0 || e < best_energy)){
+                best_energy = e;
+                best_choice = c;
+                best_mode = m;
+                best_st = st;
+                strcpy(best_label, label);
+            }
+        }
+    }
+
+    if (cache){
+        printf("  (result cache: %d hits, %d simulated)\n", cache_hits, cache_misses);
+        sched_cache_close(cache);
+    }
+    if (best_choice < 0){
+        printf("\nNo combination meets every deadline.\n");
+        return 0;
+    }
+    printf("\n=== Cheapest without misses: %s, %s (Total=%.2f) ===\n",
+           best_label, MODE_NAMES[best_mode], best_energy);
+    breakdown(input, &best_st);
+    return 0;
+}
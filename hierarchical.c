@@ -0,0 +1,444 @@
+// hierarchical.c
+// Two-level scheduling: periodic resource servers (Pi, Theta) scheduled by a
+// global EDF or RM scheduler, each running its own EDF or RM task set.
+// Build: gcc -O2 -std=c11 hierarchical.c -o hierarchical
+// Run:   ./hierarchical [input_file] [--global edf|rm] [--freq 0-3] [--end T]
+//
+// Input (default hier_input.txt):
+//   numComponents T_end
+//   then per component:  name EDF|RM server_period numTasks
+//   and per task:        name period wcet1188 wcet918 wcet648 wcet384
+// A server_period of 0 lets the tool pick the period with the smallest
+// bandwidth.
+//
+// Analysis follows the periodic resource model (Shin & Lee): a server that
+// supplies Theta every Pi guarantees at least sbf(t) in any window of
+// length t, and a component is schedulable if its demand (EDF: dbf, RM:
+// per-task request bound at the scheduling points) stays below sbf. The
+// minimum Theta for each component comes from a binary search; the servers
+// then form an ordinary periodic task set for the global test.
+//
+// The simulation runs the servers as idling periodic servers (budget is
+// consumed whenever the server is scheduled, with or without work) so
+// every component sees exactly the supply the analysis assumes. Inside a
+// component, jobs are handled as in EDF.cpp / RM_Scheduler.c, including
+// dropping late jobs.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_COMPONENTS 16
+#define MAX_TASKS      32         // per component
+#define NUM_FREQS      4
+#define READY_QUEUE_SIZE 128
+#define MAX_AUTO_PERIOD  2000     // largest server period tried automatically
+#define MAX_CHECKPOINTS  5000000  // EDF demand checkpoints per test
+
+typedef enum { POLICY_EDF, POLICY_RM } Policy;
+
+static const int FREQUENCIES[NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    char name[32];
+    uint32_t period;           // T_i (= D_i)
+    uint32_t wcet[NUM_FREQS];  // C_i at each frequency
+} Task;
+
+typedef struct {
+    int task_id;
+    uint64_t release_time;
+    uint64_t abs_deadline;
+    uint32_t remaining;   // ticks left
+    uint64_t job_seq;
+} Job;
+
+typedef struct {
+    char name[32];
+    Policy policy;
+    uint32_t server_period;    // Pi (0 in the input: choose)
+    uint32_t budget;           // Theta (0: no feasible budget)
+    int n;
+    Task tasks[MAX_TASKS];
+    uint64_t next_seq[MAX_TASKS];
+
+    // Inner scheduler state
+    Job readyJobs[READY_QUEUE_SIZE];
+    int readyJobCount;
+    bool cpu_busy;
+    Job currentJob;
+
+    // Server state
+    uint32_t budget_left;
+    uint64_t server_deadline;
+
+    // Results
+    uint64_t completed, preemptions, misses;
+    uint64_t used, idle_budget, overruns;
+} Component;
+
+static Component comps[MAX_COMPONENTS];
+static int num_comps = 0;
+static int level = 0;
+
+// ---------- Input ----------
+static bool load_input(const char *path, uint64_t *t_end){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    unsigned long long end;
+    bool ok = fscanf(f, "%d %llu", &num_comps, &end) == 2 &&
+              num_comps > 0 && num_comps <= MAX_COMPONENTS;
+    for (int c = 0; ok && c < num_comps; ++c){
+        Component *k = &comps[c];
+        char pol[8];
+        ok = fscanf(f, "%31s %7s %u %d", k->name, pol, &k->server_period, &k->n) == 4 &&
+             k->n > 0 && k->n <= MAX_TASKS &&
+             (strcmp(pol, "EDF") == 0 || strcmp(pol, "RM") == 0);
+        if (!ok) break;
+        k->policy = (strcmp(pol, "EDF") == 0) ? POLICY_EDF : POLICY_RM;
+        for (int i = 0; ok && i < k->n; ++i){
+            Task *t = &k->tasks[i];
+            ok = fscanf(f, "%31s %u %u %u %u %u", t->name, &t->period,
+                        &t->wcet[0], &t->wcet[1], &t->wcet[2], &t->wcet[3]) == 6 &&
+                 t->period > 0 && t->wcet[0] > 0 && t->wcet[1] > 0 &&
+                 t->wcet[2] > 0 && t->wcet[3] > 0;
+        }
+    }
+    fclose(f);
+    *t_end = end;
+    return ok;
+}
+
+static double utilization(const Component *k){
+    double u = 0.0;
+    for (int i = 0; i < k->n; ++i) u += (double)k->tasks[i].wcet[level] / k->tasks[i].period;
+    return u;
+}
+
+// ---------- Periodic resource model ----------
+// Minimum supply of (Pi, Theta) in any window of length t. The worst case
+// starts right after a budget was supplied as early as possible, followed
+// by one that comes as late as possible: a blackout of 2(Pi - Theta).
+static uint64_t sbf(uint32_t pi, uint32_t theta, uint64_t t){
+    if (theta >= pi) return t;
+    uint64_t gap = pi - theta;
+    if (t <= gap) return 0;
+    uint64_t k = (t - gap + pi - 1) / pi;   // ceil((t - (Pi - Theta)) / Pi)
+    if (k < 1) k = 1;
+    uint64_t lo = (k + 1) * pi - 2 * theta;
+    if (t >= lo && t <= (k + 1) * pi - theta) return t - (k + 1) * gap;
+    return (k - 1) * theta;
+}
+
+// EDF: dbf(t) <= sbf(t) at every absolute deadline. With bandwidth
+// alpha = Theta/Pi above U, sbf(t) >= alpha (t - 2(Pi - Theta)) >= U t >= dbf(t)
+// beyond t* = 2 alpha (Pi - Theta) / (alpha - U), which bounds the scan.
+static bool edf_ok(const Component *k, uint32_t pi, uint32_t theta){
+    double u = utilization(k), alpha = (double)theta / pi;
+    if (u > alpha) return false;
+    uint64_t limit = UINT64_MAX;
+    if (alpha > u) limit = (uint64_t)(2.0 * alpha * (pi - theta) / (alpha - u)) + 1;
+
+    uint64_t next_d[MAX_TASKS], demand = 0;
+    for (int i = 0; i < k->n; ++i) next_d[i] = k->tasks[i].period;
+    for (int step = 0; step < MAX_CHECKPOINTS; ++step){
+        uint64_t t = UINT64_MAX;
+        for (int i = 0; i < k->n; ++i) if (next_d[i] < t) t = next_d[i];
+        if (t > limit) return true;
+        for (int i = 0; i < k->n; ++i){
+            if (next_d[i] == t){
+                demand += k->tasks[i].wcet[level];
+                next_d[i] += k->tasks[i].period;
+            }
+        }
+        if (demand > sbf(pi, theta, t)) return false;
+    }
+    return false;   // alpha == U and no hyperperiod in reach: do not claim it
+}
+
+// RM: each task needs a scheduling point t <= D_i with
+// C_i + sum_{higher priority j} ceil(t / T_j) C_j <= sbf(t).
+// Priority as in rq_highest_rm_idx(): shorter period, then lower index.
+static bool rm_ok(const Component *k, uint32_t pi, uint32_t theta){
+    for (int i = 0; i < k->n; ++i){
+        const Task *ti = &k->tasks[i];
+        bool found = false;
+        for (int j = -1; j < k->n && !found; ++j){
+            // Points: D_i itself (j == -1) and multiples of each higher-priority T_j.
+            bool hp = j >= 0 && j != i && (k->tasks[j].period < ti->period ||
+                                            (k->tasks[j].period == ti->period && j < i));
+            if (j >= 0 && !hp) continue;
+            uint64_t step = (j < 0) ? ti->period : k->tasks[j].period;
+            for (uint64_t t = step; t <= ti->period && !found; t += step){
+                if (j < 0 && t != ti->period) continue;
+                uint64_t rbf = ti->wcet[level];
+                for (int h = 0; h < k->n; ++h){
+                    const Task *th = &k->tasks[h];
+                    if (h != i && (th->period < ti->period || (th->period == ti->period && h < i)))
+                        rbf += (t + th->period - 1) / th->period * th->wcet[level];
+                }
+                if (rbf <= sbf(pi, theta, t)) found = true;
+            }
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+static bool component_ok(const Component *k, uint32_t pi, uint32_t theta){
+    return k->policy == POLICY_EDF ? edf_ok(k, pi, theta) : rm_ok(k, pi, theta);
+}
+
+// Smallest Theta that makes the component schedulable with period Pi, 0 if none.
+static uint32_t min_budget(const Component *k, uint32_t pi){
+    if (!component_ok(k, pi, pi)) return 0;
+    uint32_t lo = 0, hi = pi;   // component_ok(hi) holds, component_ok(lo) does not
+    while (hi - lo > 1){
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (component_ok(k, pi, mid)) hi = mid; else lo = mid;
+    }
+    return hi;
+}
+
+// Period with the smallest bandwidth Theta/Pi; ties go to the longer
+// period (fewer server switches).
+static void choose_server(Component *k){
+    if (k->server_period){
+        k->budget = min_budget(k, k->server_period);
+        return;
+    }
+    uint32_t max_pi = UINT32_MAX;
+    for (int i = 0; i < k->n; ++i) if (k->tasks[i].period < max_pi) max_pi = k->tasks[i].period;
+    if (max_pi > MAX_AUTO_PERIOD) max_pi = MAX_AUTO_PERIOD;
+    k->server_period = 1;
+    k->budget = 0;
+    for (uint32_t pi = 1; pi <= max_pi; ++pi){
+        uint32_t theta = min_budget(k, pi);
+        if (theta == 0) continue;
+        if (k->budget == 0 || (uint64_t)theta * k->server_period <= (uint64_t)k->budget * pi){
+            k->server_period = pi;
+            k->budget = theta;
+        }
+    }
+}
+
+// Servers are periodic tasks (Pi, Theta) with implicit deadlines.
+static bool global_ok(Policy global){
+    double u = 0.0;
+    for (int c = 0; c < num_comps; ++c){
+        if (comps[c].budget == 0) return false;
+        u += (double)comps[c].budget / comps[c].server_period;
+    }
+    if (global == POLICY_EDF) return u <= 1.0;
+    for (int c = 0; c < num_comps; ++c){
+        const Component *s = &comps[c];
+        uint64_t r = s->budget, prev = 0;
+        while (r != prev && r <= s->server_period){
+            prev = r;
+            r = s->budget;
+            for (int d = 0; d < num_comps; ++d){
+                const Component *o = &comps[d];
+                if (d != c && (o->server_period < s->server_period ||
+                               (o->server_period == s->server_period && d < c)))
+                    r += (prev + o->server_period - 1) / o->server_period * o->budget;
+            }
+        }
+        if (r > s->server_period) return false;
+    }
+    return true;
+}
+
+// ---------- Inner scheduler (EDF.cpp / RM_Scheduler.c) ----------
+static void rq_push(Component *k, Job j){
+    if (k->readyJobCount < READY_QUEUE_SIZE) {
+        k->readyJobs[k->readyJobCount++] = j;
+    } else {
+        fprintf(stderr, "Ready queue full in %s; dropping job!\n", k->name);
+    }
+}
+
+static void rq_remove_idx(Component *k, int idx){
+    if (idx < 0 || idx >= k->readyJobCount) return;
+    k->readyJobs[idx] = k->readyJobs[--k->readyJobCount];
+}
+
+static int rq_best_idx(const Component *k){
+    if (k->readyJobCount == 0) return -1;
+    int best = 0;
+    for (int i = 1; i < k->readyJobCount; ++i){
+        const Job *a = &k->readyJobs[i], *b = &k->readyJobs[best];
+        if (k->policy == POLICY_EDF){
+            if (a->abs_deadline < b->abs_deadline) best = i;
+        } else {
+            uint32_t pa = k->tasks[a->task_id].period, pb = k->tasks[b->task_id].period;
+            if (pa < pb) best = i;
+            else if (pa == pb){
+                if (a->abs_deadline < b->abs_deadline) best = i;
+                else if (a->abs_deadline == b->abs_deadline && a->task_id < b->task_id) best = i;
+            }
+        }
+    }
+    return best;
+}
+
+static void release_and_drop(Component *k, uint64_t t){
+    for (int i = 0; i < k->n; ++i){
+        if (t % k->tasks[i].period == 0){
+            Job j;
+            j.task_id = i;
+            j.release_time = t;
+            j.abs_deadline = t + k->tasks[i].period;
+            j.remaining = k->tasks[i].wcet[level];
+            j.job_seq = k->next_seq[i]++;
+            rq_push(k, j);
+        }
+    }
+    if (k->cpu_busy && t > k->currentJob.abs_deadline && k->currentJob.remaining > 0){
+        k->misses++;
+        k->cpu_busy = false;
+    }
+    for (int i = 0; i < k->readyJobCount; ++i){
+        if (t > k->readyJobs[i].abs_deadline && k->readyJobs[i].remaining > 0){
+            k->misses++;
+            rq_remove_idx(k, i);
+            i--; // Adjust index after removal
+        }
+    }
+}
+
+// One tick of supply from the component's server.
+static void run_inner(Component *k){
+    int idx = rq_best_idx(k);
+    if (!k->cpu_busy){
+        if (idx != -1){
+            k->currentJob = k->readyJobs[idx];
+            rq_remove_idx(k, idx);
+            k->cpu_busy = true;
+        }
+    } else if (idx != -1){
+        const Job *b = &k->readyJobs[idx];
+        bool preempt = (k->policy == POLICY_EDF)
+            ? b->abs_deadline < k->currentJob.abs_deadline
+            : k->tasks[b->task_id].period < k->tasks[k->currentJob.task_id].period;
+        if (preempt){
+            rq_push(k, k->currentJob);
+            k->currentJob = k->readyJobs[idx];
+            rq_remove_idx(k, idx);
+            k->preemptions++;
+        }
+    }
+    if (!k->cpu_busy){
+        k->idle_budget++;
+        return;
+    }
+    k->used++;
+    if (--k->currentJob.remaining == 0){
+        k->completed++;
+        k->cpu_busy = false;
+    }
+}
+
+// ---------- Global scheduler ----------
+static uint64_t simulate(Policy global, uint64_t end){
+    uint64_t idle = 0;
+    for (uint64_t t = 0; t <= end; ++t){
+        for (int c = 0; c < num_comps; ++c){
+            Component *k = &comps[c];
+            release_and_drop(k, t);
+            if (t % k->server_period == 0){
+                if (k->budget_left > 0) k->overruns++;   // budget not delivered in time
+                k->budget_left = k->budget;
+                k->server_deadline = t + k->server_period;
+            }
+        }
+        int s = -1;
+        for (int c = 0; c < num_comps; ++c){
+            const Component *k = &comps[c];
+            if (k->budget_left == 0) continue;
+            if (s < 0) { s = c; continue; }
+            if (global == POLICY_EDF ? k->server_deadline < comps[s].server_deadline
+                                     : k->server_period < comps[s].server_period)
+                s = c;
+        }
+        if (s < 0){
+            idle++;
+            continue;
+        }
+        comps[s].budget_left--;
+        run_inner(&comps[s]);
+    }
+    return idle;
+}
+
+int main(int argc, char **argv){
+    const char *input = "hier_input.txt";
+    Policy global = POLICY_EDF;
+    uint64_t end = 0, t_end = 0;
+    int k = 1;
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--global") == 0 && k + 1 < argc){
+            ++k;
+            if (strcmp(argv[k], "edf") == 0) global = POLICY_EDF;
+            else if (strcmp(argv[k], "rm") == 0) global = POLICY_RM;
+            else break;
+        } else if (strcmp(argv[k], "--freq") == 0 && k + 1 < argc){
+            level = atoi(argv[++k]);
+            if (level < 0 || level >= NUM_FREQS) break;
+        } else if (strcmp(argv[k], "--end") == 0 && k + 1 < argc){
+            end = strtoull(argv[++k], NULL, 10);
+        } else {
+            break;
+        }
+    }
+    if (k < argc){
+        fprintf(stderr, "Usage: %s [input_file] [--global edf|rm] [--freq 0-3] [--end T]\n", argv[0]);
+        return 1;
+    }
+    if (!load_input(input, &t_end)){
+        fprintf(stderr, "Cannot read components from %s\n", input);
+        return 1;
+    }
+    if (end) t_end = end;
+
+    printf("=== Component interfaces @ %d MHz (periodic resource model) ===\n", FREQUENCIES[level]);
+    double bandwidth = 0.0, demand = 0.0;
+    for (int c = 0; c < num_comps; ++c){
+        Component *kc = &comps[c];
+        bool chosen = kc->server_period == 0;
+        choose_server(kc);
+        double u = utilization(kc);
+        demand += u;
+        if (kc->budget == 0){
+            printf("  %-10s %-3s U=%.4f  Pi=%u: not schedulable with any budget\n", kc->name,
+                   kc->policy == POLICY_EDF ? "EDF" : "RM", u, kc->server_period);
+            continue;
+        }
+        double bw = (double)kc->budget / kc->server_period;
+        bandwidth += bw;
+        printf("  %-10s %-3s U=%.4f  Pi=%-5u Theta=%-5u bandwidth=%.4f  overhead=%.4f%s\n",
+               kc->name, kc->policy == POLICY_EDF ? "EDF" : "RM", u, kc->server_period,
+               kc->budget, bw, bw - u, chosen ? "  (period chosen)" : "");
+    }
+    bool ok = global_ok(global);
+    printf("Total: U=%.4f  server bandwidth=%.4f  global %s: %s\n", demand, bandwidth,
+           global == POLICY_EDF ? "EDF" : "RM", ok ? "schedulable" : "NOT schedulable");
+
+    for (int c = 0; c < num_comps; ++c)
+        if (comps[c].budget == 0) return 1;
+
+    uint64_t idle = simulate(global, t_end);
+    printf("\n=== Simulation, t <= %llu ===\n", (unsigned long long)t_end);
+    for (int c = 0; c < num_comps; ++c){
+        const Component *kc = &comps[c];
+        printf("  %-10s Completed=%llu, Preemptions=%llu, Misses=%llu, Used=%llu, "
+               "Unused budget=%llu, Server overruns=%llu\n",
+               kc->name, (unsigned long long)kc->completed, (unsigned long long)kc->preemptions,
+               (unsigned long long)kc->misses, (unsigned long long)kc->used,
+               (unsigned long long)kc->idle_budget, (unsigned long long)kc->overruns);
+    }
+    printf("  CPU idle=%llu\n", (unsigned long long)idle);
+    return 0;
+}
@@ -1,18 +1,51 @@
 // sched_sim.c
-// One file, two schedulers: EDF or RM (select via argv[1])
+// One file, several schedulers: EDF, RM, LLF, EDZL or PD2 (select via argv[1])
 // Build: gcc -O2 -std=c11 sched_sim.c -o sched_sim
-// Run:   ./sched_sim edf   OR   ./sched_sim rm
+// Run:   ./sched_sim edf   OR   ./sched_sim rm   (also llf, edzl, pd2)
+//        ./sched_sim edf trace.csv   (replay recorded releases, see below)
+//
+// LLF and EDZL need every job's laxity d - t - remaining, which changes each
+// tick for every waiting job. Instead each job is keyed by its zero-laxity
+// instant d - remaining: the laxity at t is that key minus t, the same
+// shift for all jobs, so the order by key is the order by laxity at any
+// common epoch. A waiting job's key never changes and the running job's
+// only grows as it executes, so nothing is recomputed per tick.
+//
+// PD2 is the Pfair scheduler for one processor here: a job of weight
+// w = C/T is split into unit subtasks, subtask k may only run in its
+// window [r + floor((k-1)/w), r + ceil(k/w)), and subtasks are ordered by
+// window end, then the b-bit, then the group deadline. Pfair assumes
+// D = T; with trace replay the windows still come from the WCET. A job
+// that stops because its next window has not opened yet is a quantum end,
+// counted apart from preemptions (a still eligible job displaced by
+// another), the same split as in multiproc.c.
+//
+// Trace replay: instead of strictly periodic releases running for exactly
+// wcet, jobs come from a recorded arrival log sorted by release time.
+//   CSV:    one "release,task,exec" per line; task is a name or an index,
+//           exec is the actual execution time in ticks; '#' starts a comment
+//   Binary: TRACE_MAGIC header, then TraceRecord entries (16 bytes each)
+// The log is streamed (one record of lookahead; binary files are mapped in
+// fixed windows), so memory stays bounded for multi-gigabyte traces.
 
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #define MAX_TASKS  8
 #define MAX_READY  128
 #define SIM_END    100  // simulate ticks [0..SIM_END]
 
-typedef enum { POLICY_EDF, POLICY_RM } Policy;
+typedef enum { POLICY_EDF, POLICY_RM, POLICY_LLF, POLICY_EDZL, POLICY_PD2 } Policy;
+
+static const char *POLICY_NAMES[] = { "EDF", "RM", "LLF", "EDZL", "PD2" };
 
 typedef struct {
     const char *name;
@@ -28,6 +61,7 @@ typedef struct {
     uint64_t abs_deadline;
     uint32_t remaining;   // ticks left (at current "speed")
     uint64_t job_seq;     // 0,1,2,... per task
+    uint32_t executed;    // ticks run so far (PD2: index of the next subtask - 1)
 } Job;
 
 // ---------- Ready queue as a simple array ----------
@@ -72,20 +106,306 @@ static inline bool higher_rm(const Task *tasks, int a_task, int b_task){
     return a_task < b_task;
 }
 
-static int pick_ready_idx(Policy pol, const Task *tasks){
-    return (pol == POLICY_EDF) ? rq_earliest_deadline_idx()
-                               : rq_highest_rm_idx(tasks);
+// ---------- Laxity (LLF, EDZL) ----------
+// Zero-laxity instant: the job must run without a break from here on.
+static inline int64_t zero_laxity_time(const Job *j){
+    return (int64_t)j->abs_deadline - (int64_t)j->remaining;
+}
+static inline int64_t laxity(const Job *j, uint64_t t){
+    return zero_laxity_time(j) - (int64_t)t;
+}
+
+// LLF: smallest laxity. Tie: earlier deadline, then smaller task_id.
+static int rq_least_laxity_idx(void){
+    if (RQ_sz == 0) return -1;
+    int best = 0;
+    for (int i = 1; i < RQ_sz; ++i){
+        int64_t a = zero_laxity_time(&RQ[i]), b = zero_laxity_time(&RQ[best]);
+        if (a < b) best = i;
+        else if (a == b){
+            if (RQ[i].abs_deadline < RQ[best].abs_deadline) best = i;
+            else if (RQ[i].abs_deadline == RQ[best].abs_deadline && RQ[i].task_id < RQ[best].task_id)
+                best = i;
+        }
+    }
+    return best;
+}
+
+// EDZL: a job at zero laxity goes first, otherwise EDF.
+static int rq_edzl_idx(uint64_t t){
+    int best = rq_least_laxity_idx();
+    if (best != -1 && laxity(&RQ[best], t) <= 0) return best;
+    return rq_earliest_deadline_idx();
+}
+
+// ---------- PD2 ----------
+// Window of the job's next subtask k = executed + 1, relative to its release.
+static uint64_t pf_release(const Task *ti, const Job *j){
+    return j->release_time + (uint64_t)j->executed * ti->period / ti->wcet;
+}
+static uint64_t pf_deadline(const Task *ti, const Job *j){
+    uint64_t k = j->executed + 1;
+    return j->release_time + (k * ti->period + ti->wcet - 1) / ti->wcet;
+}
+// 1 if the window overlaps the next one
+static int pf_bbit(const Task *ti, const Job *j){
+    return ((uint64_t)(j->executed + 1) * ti->period % ti->wcet) != 0;
+}
+// Heavy tasks (w >= 1/2): end of the run of overlapping windows of length
+// two that the subtask starts, ceil(ceil(d (1 - w)) / (1 - w)). 0 for light ones.
+static uint64_t pf_group_deadline(const Task *ti, const Job *j){
+    if (2 * (uint64_t)ti->wcet < ti->period) return 0;
+    if (ti->wcet >= ti->period) return UINT64_MAX;
+    uint64_t T = ti->period, idle = T - ti->wcet;
+    uint64_t d = pf_deadline(ti, j) - j->release_time;
+    uint64_t x = (d * idle + T - 1) / T;
+    return j->release_time + (x * T + idle - 1) / idle;
+}
+static bool pf_eligible(const Task *tasks, const Job *j, uint64_t t){
+    return pf_release(&tasks[j->task_id], j) <= t;
+}
+static bool pf_higher(const Task *tasks, const Job *a, const Job *b){
+    const Task *ta = &tasks[a->task_id], *tb = &tasks[b->task_id];
+    uint64_t da = pf_deadline(ta, a), db = pf_deadline(tb, b);
+    if (da != db) return da < db;
+    int ba = pf_bbit(ta, a), bb = pf_bbit(tb, b);
+    if (ba != bb) return ba > bb;
+    uint64_t ga = pf_group_deadline(ta, a), gb = pf_group_deadline(tb, b);
+    if (ga != gb) return ga > gb;
+    return a->task_id < b->task_id;
+}
+// Highest-priority job whose next subtask is released, -1 if none.
+static int rq_pd2_idx(const Task *tasks, uint64_t t){
+    int best = -1;
+    for (int i = 0; i < RQ_sz; ++i){
+        if (!pf_eligible(tasks, &RQ[i], t)) continue;
+        if (best == -1 || pf_higher(tasks, &RQ[i], &RQ[best])) best = i;
+    }
+    return best;
+}
+
+static int pick_ready_idx(Policy pol, const Task *tasks, uint64_t t){
+    switch (pol){
+    case POLICY_EDF:  return rq_earliest_deadline_idx();
+    case POLICY_RM:   return rq_highest_rm_idx(tasks);
+    case POLICY_LLF:  return rq_least_laxity_idx();
+    case POLICY_EDZL: return rq_edzl_idx(t);
+    case POLICY_PD2:  return rq_pd2_idx(tasks, t);
+    }
+    return -1;
 }
 
-static bool preempt_needed(Policy pol, const Task *tasks, const Job *cur){
+static bool preempt_needed(Policy pol, const Task *tasks, const Job *cur, uint64_t t){
+    // PD2 decides every quantum, and a job whose next subtask is not
+    // released yet has to give up the CPU.
+    if (pol == POLICY_PD2 && !pf_eligible(tasks, cur, t)) return true;
     if (RQ_sz == 0) return false;
-    if (pol == POLICY_EDF){
-        int best = rq_earliest_deadline_idx();
-        return (best != -1 && RQ[best].abs_deadline < cur->abs_deadline);
-    } else { // RM
-        int best = rq_highest_rm_idx(tasks);
-        return (best != -1 && higher_rm(tasks, RQ[best].task_id, cur->task_id));
+    int best = pick_ready_idx(pol, tasks, t);
+    if (best == -1) return false;
+    switch (pol){
+    case POLICY_EDF:
+        return RQ[best].abs_deadline < cur->abs_deadline;
+    case POLICY_RM:
+        return higher_rm(tasks, RQ[best].task_id, cur->task_id);
+    case POLICY_LLF:
+        // Strictly smaller laxity only, or equal laxities would swap every tick
+        return zero_laxity_time(&RQ[best]) < zero_laxity_time(cur);
+    case POLICY_EDZL:
+        if (laxity(cur, t) <= 0) return false;
+        return laxity(&RQ[best], t) <= 0 || RQ[best].abs_deadline < cur->abs_deadline;
+    case POLICY_PD2:
+        return pf_higher(tasks, &RQ[best], cur);
+    }
+    return false;
+}
+
+static void print_sched(const char *what, Policy pol, const Task *tasks, const Job *j, uint64_t t){
+    printf("[t=%llu] %s %s#%llu (", (unsigned long long)t, what, tasks[j->task_id].name,
+           (unsigned long long)j->job_seq);
+    if (pol == POLICY_RM) printf("prio T=%u, ", tasks[j->task_id].period);
+    else if (pol == POLICY_LLF || pol == POLICY_EDZL) printf("lax=%lld, ", (long long)laxity(j, t));
+    else if (pol == POLICY_PD2)
+        printf("subtask %u due %llu, ", j->executed + 1,
+               (unsigned long long)pf_deadline(&tasks[j->task_id], j));
+    printf("dl=%llu, rem=%u)\n", (unsigned long long)j->abs_deadline, j->remaining);
+}
+
+// ---------- Recorded arrival traces ----------
+#define TRACE_MAGIC   "PA3TRACE"
+#define TRACE_VERSION 1u
+#define TRACE_WINDOW  (64u << 20)  // bytes of a binary trace mapped at once
+
+typedef struct {
+    uint64_t release;   // release time (ticks)
+    uint32_t task_id;   // index into tasks[]
+    uint32_t exec;      // actual execution time (ticks), usually < wcet
+} TraceRecord;
+
+typedef struct {
+    FILE *csv;                   // CSV source, or NULL for binary
+    int fd;                      // binary source
+    off_t file_size, win_off;    // binary: file size, offset of current window
+    void *map;                   // binary: page-aligned mapping holding the window
+    size_t map_len;
+    const unsigned char *win;    // binary: first record of the window
+    size_t win_len, win_pos;
+    uint64_t line;               // CSV line number (for error messages)
+    uint64_t last_release;
+    bool has_next;
+    bool error;                  // malformed trace or I/O error, not end of trace
+    TraceRecord next;            // one record of lookahead
+} Trace;
+
+// Maps the window of records starting at file offset off. mmap offsets must
+// be page aligned, so the mapping starts at the page holding off.
+static bool trace_map_window(Trace *tr, off_t off){
+    if (tr->map) munmap(tr->map, tr->map_len);
+    tr->map = NULL;
+    tr->win = NULL;
+    tr->win_off = off;
+    tr->win_pos = 0;
+    tr->win_len = 0;
+    if (off >= tr->file_size) return false;
+    size_t len = (size_t)(tr->file_size - off);
+    if (len > TRACE_WINDOW) len = TRACE_WINDOW;
+    off_t base = off - off % sysconf(_SC_PAGESIZE);
+    size_t map_len = len + (size_t)(off - base);
+    void *p = mmap(NULL, map_len, PROT_READ, MAP_PRIVATE, tr->fd, base);
+    if (p == MAP_FAILED){
+        perror("mmap trace");
+        tr->error = true;
+        return false;
     }
+    posix_madvise(p, map_len, POSIX_MADV_SEQUENTIAL);
+    tr->map = p;
+    tr->map_len = map_len;
+    tr->win = (const unsigned char *)p + (off - base);
+    tr->win_len = len;
+    return true;
+}
+
+static int find_task(const Task *tasks, int N, const char *s){
+    for (int i = 0; i < N; ++i)
+        if (strcmp(tasks[i].name, s) == 0) return i;
+    char *end;
+    long v = strtol(s, &end, 10);
+    return (*s && *end == '\0' && v >= 0 && v < N) ? (int)v : -1;
+}
+
+// Loads the next record into tr->next. Returns false at end of trace or on
+// error; the two are told apart by tr->error.
+static bool trace_advance(Trace *tr, const Task *tasks, int N){
+    tr->has_next = false;
+    TraceRecord r;
+    if (tr->csv){
+        char buf[256], name[64];
+        unsigned long long rel;
+        unsigned exec;
+        for (;;){
+            if (!fgets(buf, sizeof buf, tr->csv)){
+                if (ferror(tr->csv)){
+                    perror("read trace");
+                    tr->error = true;
+                }
+                return false;
+            }
+            tr->line++;
+            char *p = buf + strspn(buf, " \t");
+            if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+            if (sscanf(p, "%llu ,%63[^,] ,%u", &rel, name, &exec) != 3){
+                fprintf(stderr, "Trace line %llu: expected release,task,exec\n",
+                        (unsigned long long)tr->line);
+                tr->error = true;
+                return false;
+            }
+            name[strcspn(name, " \t")] = '\0';
+            int id = find_task(tasks, N, name);
+            if (id < 0){
+                fprintf(stderr, "Trace line %llu: unknown task '%s'\n",
+                        (unsigned long long)tr->line, name);
+                tr->error = true;
+                return false;
+            }
+            r.release = rel;
+            r.task_id = (uint32_t)id;
+            r.exec = exec;
+            break;
+        }
+    } else {
+        if (tr->win_pos + sizeof r > tr->win_len){
+            if (tr->win_pos < tr->win_len){
+                fprintf(stderr, "Trace ends in a partial record\n");
+                tr->error = true;
+                return false;
+            }
+            if (!trace_map_window(tr, tr->win_off + (off_t)tr->win_len)) return false;
+            if (tr->win_len < sizeof r){
+                fprintf(stderr, "Trace ends in a partial record\n");
+                tr->error = true;
+                return false;
+            }
+        }
+        memcpy(&r, tr->win + tr->win_pos, sizeof r);
+        tr->win_pos += sizeof r;
+        if (r.task_id >= (uint32_t)N){
+            fprintf(stderr, "Trace record %llu: bad task id %u\n",
+                    (unsigned long long)((tr->win_off + (off_t)tr->win_pos) / sizeof r - 2),
+                    r.task_id);
+            tr->error = true;
+            return false;
+        }
+    }
+    if (r.release < tr->last_release){
+        fprintf(stderr, "Trace is not sorted by release time (%llu after %llu)\n",
+                (unsigned long long)r.release, (unsigned long long)tr->last_release);
+        tr->error = true;
+        return false;
+    }
+    tr->last_release = r.release;
+    tr->next = r;
+    tr->has_next = true;
+    return true;
+}
+
+static void trace_close(Trace *tr){
+    if (tr->csv) fclose(tr->csv);
+    if (tr->map) munmap(tr->map, tr->map_len);
+    if (tr->fd >= 0) close(tr->fd);
+}
+
+static bool trace_open(Trace *tr, const char *path, const Task *tasks, int N){
+    memset(tr, 0, sizeof *tr);
+    tr->fd = open(path, O_RDONLY);
+    if (tr->fd < 0) return false;
+
+    char hdr[16];
+    struct stat st;
+    if (fstat(tr->fd, &st) == 0 && st.st_size >= (off_t)sizeof hdr &&
+        read(tr->fd, hdr, sizeof hdr) == (ssize_t)sizeof hdr &&
+        memcmp(hdr, TRACE_MAGIC, 8) == 0){
+        uint32_t version, rec_size;
+        memcpy(&version, hdr + 8, 4);
+        memcpy(&rec_size, hdr + 12, 4);
+        if (version != TRACE_VERSION || rec_size != sizeof(TraceRecord)){
+            fprintf(stderr, "%s: unsupported trace version %u\n", path, version);
+            close(tr->fd);
+            return false;
+        }
+        tr->file_size = st.st_size;
+        // Windows hold whole records (TRACE_WINDOW is a multiple of the
+        // record size), so a record never straddles two mappings.
+        tr->win_off = (off_t)sizeof hdr;   // first advance maps from here
+    } else {
+        close(tr->fd);
+        tr->fd = -1;
+        tr->csv = fopen(path, "r");
+        if (!tr->csv) return false;
+    }
+    if (!trace_advance(tr, tasks, N) && tr->error){
+        trace_close(tr);
+        return false;
+    }
+    return true;
 }
 
 // ---------- Demo tasks (D_i = T_i). Tweak as needed ----------
@@ -105,8 +425,11 @@ int main(int argc, char **argv){
     if (argc >= 2){
         if (strcmp(argv[1], "edf") == 0) pol = POLICY_EDF;
         else if (strcmp(argv[1], "rm") == 0) pol = POLICY_RM;
+        else if (strcmp(argv[1], "llf") == 0) pol = POLICY_LLF;
+        else if (strcmp(argv[1], "edzl") == 0) pol = POLICY_EDZL;
+        else if (strcmp(argv[1], "pd2") == 0) pol = POLICY_PD2;
         else {
-            fprintf(stderr, "Usage: %s [edf|rm]\n", argv[0]);
+            fprintf(stderr, "Usage: %s [edf|rm|llf|edzl|pd2] [trace.csv|trace.bin]\n", argv[0]);
             return 1;
         }
     }
@@ -115,26 +438,64 @@ int main(int argc, char **argv){
     int N = 0;
     load_example_tasks(tasks, &N);
 
-    uint64_t t = 0, completed = 0, preemptions = 0, misses = 0;
+    Trace tr;
+    bool replay = (argc >= 3);
+    if (replay && !trace_open(&tr, argv[2], tasks, N)){
+        fprintf(stderr, "Cannot open trace %s\n", argv[2]);
+        return 1;
+    }
+
+    uint64_t t = 0, completed = 0, preemptions = 0, misses = 0, quantum_ends = 0;
     uint64_t next_seq[MAX_TASKS] = {0};
+    uint64_t busy_ticks = 0, idle_ticks = 0, wcet_demand = 0, actual_demand = 0;
+    uint64_t slack = 0, overrun = 0;   // per job: WCET - exec, or exec - WCET
     bool cpu_busy = false;
     Job cur = {0};
 
-    printf("=== %s-only (no DVFS, no energy) ===\n",
-           (pol == POLICY_EDF) ? "EDF" : "RM");
+    printf("=== %s-only (no DVFS, no energy)%s ===\n",
+           POLICY_NAMES[pol], replay ? " trace replay" : "");
 
-    for (t = 0; t <= SIM_END; ++t){
+    for (t = 0; replay ? (tr.has_next || RQ_sz > 0 || cpu_busy) : t <= SIM_END; ++t){
         // 1) Releases at time t
-        for (int i = 0; i < N; ++i){
-            Task *ti = &tasks[i];
-            if (t >= ti->phase && ((t - ti->phase) % ti->period == 0)){
+        if (replay){
+            // Nothing can happen before the next recorded release: skip ahead.
+            if (!cpu_busy && RQ_sz == 0 && tr.next.release > t){
+                idle_ticks += tr.next.release - t;
+                t = tr.next.release;
+            }
+            while (tr.has_next && tr.next.release == t){
+                Task *ti = &tasks[tr.next.task_id];
                 Job j;
-                j.task_id = i;
+                j.task_id = (int)tr.next.task_id;
                 j.release_time = t;
                 j.abs_deadline = t + ti->deadline;
-                j.remaining = ti->wcet;
-                j.job_seq = next_seq[i]++;
-                rq_push(j);
+                j.remaining = tr.next.exec;
+                j.job_seq = next_seq[j.task_id]++;
+                j.executed = 0;
+                wcet_demand += ti->wcet;
+                actual_demand += tr.next.exec;
+                if (tr.next.exec <= ti->wcet) slack += ti->wcet - tr.next.exec;
+                else overrun += tr.next.exec - ti->wcet;
+                if (j.remaining > 0) rq_push(j);
+                else completed++;
+                if (!trace_advance(&tr, tasks, N) && tr.error){
+                    trace_close(&tr);
+                    return 1;
+                }
+            }
+        } else {
+            for (int i = 0; i < N; ++i){
+                Task *ti = &tasks[i];
+                if (t >= ti->phase && ((t - ti->phase) % ti->period == 0)){
+                    Job j;
+                    j.task_id = i;
+                    j.release_time = t;
+                    j.abs_deadline = t + ti->deadline;
+                    j.remaining = ti->wcet;
+                    j.job_seq = next_seq[i]++;
+                    j.executed = 0;
+                    rq_push(j);
+                }
             }
         }
 
@@ -158,49 +519,37 @@ int main(int argc, char **argv){
 
         // 3) Start or preempt according to policy
         if (!cpu_busy){
-            int idx = pick_ready_idx(pol, tasks);
+            int idx = pick_ready_idx(pol, tasks, t);
             if (idx != -1){
                 cur = RQ[idx];
                 rq_remove_idx(idx);
                 cpu_busy = true;
-                if (pol == POLICY_EDF){
-                    printf("[t=%llu] START %s#%llu (dl=%llu, rem=%u)\n",
-                           (unsigned long long)t, tasks[cur.task_id].name,
-                           (unsigned long long)cur.job_seq,
-                           (unsigned long long)cur.abs_deadline, cur.remaining);
-                } else {
-                    printf("[t=%llu] START %s#%llu (prio T=%u, dl=%llu, rem=%u)\n",
-                           (unsigned long long)t, tasks[cur.task_id].name,
-                           (unsigned long long)cur.job_seq,
-                           tasks[cur.task_id].period,
-                           (unsigned long long)cur.abs_deadline, cur.remaining);
-                }
+                print_sched("START", pol, tasks, &cur, t);
             }
         } else {
-            if (preempt_needed(pol, tasks, &cur)){
-                int idx = pick_ready_idx(pol, tasks); // known to exist
+            if (preempt_needed(pol, tasks, &cur, t)){
+                // PD2 only: cur's next subtask is not released yet
+                bool quantum_end = pol == POLICY_PD2 && !pf_eligible(tasks, &cur, t);
+                int idx = pick_ready_idx(pol, tasks, t); // -1 only for PD2
                 rq_push(cur);
-                cur = RQ[idx];
-                rq_remove_idx(idx);
-                preemptions++;
-                if (pol == POLICY_EDF){
-                    printf("[t=%llu] PREEMPT -> %s#%llu (dl=%llu, rem=%u)\n",
-                           (unsigned long long)t, tasks[cur.task_id].name,
-                           (unsigned long long)cur.job_seq,
-                           (unsigned long long)cur.abs_deadline, cur.remaining);
+                if (quantum_end) quantum_ends++;
+                else preemptions++;
+                if (idx == -1){
+                    cpu_busy = false;   // nothing eligible: idle
                 } else {
-                    printf("[t=%llu] PREEMPT -> %s#%llu (prio T=%u, dl=%llu, rem=%u)\n",
-                           (unsigned long long)t, tasks[cur.task_id].name,
-                           (unsigned long long)cur.job_seq,
-                           tasks[cur.task_id].period,
-                           (unsigned long long)cur.abs_deadline, cur.remaining);
+                    cur = RQ[idx];
+                    rq_remove_idx(idx);
+                    print_sched(quantum_end ? "START" : "PREEMPT ->", pol, tasks, &cur, t);
                 }
             }
         }
 
         // 4) Execute one tick
+        if (cpu_busy) busy_ticks++;
+        else idle_ticks++;
         if (cpu_busy){
             if (cur.remaining > 0) cur.remaining--;
+            cur.executed++;
             if (cur.remaining == 0){
                 printf("[t=%llu] FINISH %s#%llu\n",
                        (unsigned long long)(t + 1),
@@ -214,10 +563,21 @@ int main(int argc, char **argv){
     }
 
     printf("\nSummary (%s): Completed=%llu  Preemptions=%llu  Misses=%llu\n",
-           (pol == POLICY_EDF) ? "EDF" : "RM",
+           POLICY_NAMES[pol],
            (unsigned long long)completed,
            (unsigned long long)preemptions,
            (unsigned long long)misses);
+    if (pol == POLICY_PD2)
+        printf("Pfair quantum ends (job descheduled until its next window): %llu\n",
+               (unsigned long long)quantum_ends);
+    if (replay){
+        printf("Trace: Busy=%llu  Idle=%llu  WCET demand=%llu  Actual demand=%llu  "
+               "Reclaimed slack=%llu  Overrun=%llu\n",
+               (unsigned long long)busy_ticks, (unsigned long long)idle_ticks,
+               (unsigned long long)wcet_demand, (unsigned long long)actual_demand,
+               (unsigned long long)slack, (unsigned long long)overrun);
+        trace_close(&tr);
+    }
 
     return 0;
 }
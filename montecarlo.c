@@ -0,0 +1,332 @@
+// montecarlo.c
+// Monte Carlo execution times: jobs draw their actual demand from per-task
+// distributions, replications run in parallel on libsched, and energy, miss
+// ratio and response time are reported with confidence intervals.
+// Build: gcc -O2 -std=c11 -pthread montecarlo.c sched_lib.c -o montecarlo -lm
+// Run:   ./montecarlo [edf|rm] [input_file] [--reps N] [--threads T] [--seed S]
+//                     [--dist FILE] [--end T]
+//
+// Distribution file, one line per task (tasks not listed keep the default,
+// uniform 0.5 .. 1.0 of WCET):
+//   name uniform LO HI               fraction of WCET, uniform in [LO, HI]
+//   name hist F1:W1 F2:W2 ...        fraction F_i with weight W_i
+//
+// Every job's draw comes from Philox4x32-10 with the counter
+// (task, job_seq, replication) and the seed as key, so a replication's
+// outcome depends only on its index: results are identical for any thread
+// count, and the fixed-frequency and EE runs of one replication see the
+// same execution times (common random numbers), which makes the EE saving
+// a paired estimate.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "sched_lib.h"
+
+#define MAX_TASKS   64
+#define MAX_BINS    32
+#define MAX_THREADS 64
+#define NUM_MODES   2   // fixed 1188 MHz, static EE level
+
+typedef enum { DIST_UNIFORM, DIST_HIST } DistKind;
+
+typedef struct {
+    DistKind kind;
+    double lo, hi;                 // uniform
+    int bins;                      // histogram
+    double frac[MAX_BINS];
+    double cum[MAX_BINS];          // cumulative weight, normalized to 1
+} Dist;
+
+typedef struct {
+    double energy;
+    double miss_ratio;
+    double mean_response;          // over completed jobs
+} RepResult;
+
+// Shared, read-only while the workers run
+static sched_policy policy = SCHED_EDF;
+static sched_task tasks[MAX_TASKS];
+static char task_names[MAX_TASKS][64];
+static Dist dists[MAX_TASKS];
+static int num_tasks;
+static double power[SCHED_NUM_FREQS], power_idle;
+static uint64_t t_end;
+static uint64_t seed = 20240601;
+
+static RepResult *results[NUM_MODES];   // indexed by replication
+static int total_reps;
+static atomic_int next_rep;
+
+// ---------- Philox4x32-10 ----------
+typedef struct { uint32_t v[4]; } Philox;
+
+static Philox philox4x32_10(Philox ctr, uint32_t k0, uint32_t k1){
+    for (int r = 0; r < 10; ++r){
+        if (r > 0){
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        uint64_t p0 = (uint64_t)0xD2511F53u * ctr.v[0];
+        uint64_t p1 = (uint64_t)0xCD9E8D57u * ctr.v[2];
+        Philox n;
+        n.v[0] = (uint32_t)(p1 >> 32) ^ ctr.v[1] ^ k0;
+        n.v[1] = (uint32_t)p1;
+        n.v[2] = (uint32_t)(p0 >> 32) ^ ctr.v[3] ^ k1;
+        n.v[3] = (uint32_t)p0;
+        ctr = n;
+    }
+    return ctr;
+}
+
+// Uniform in [0, 1) from the stream position (task, job, replication).
+static double draw(int task_id, uint64_t job_seq, int rep){
+    Philox c = { { (uint32_t)task_id, (uint32_t)job_seq, (uint32_t)(job_seq >> 32), (uint32_t)rep } };
+    Philox o = philox4x32_10(c, (uint32_t)seed, (uint32_t)(seed >> 32));
+    uint64_t bits = ((uint64_t)o.v[0] << 21) ^ (o.v[1] >> 11);   // 53 bits
+    return (double)(bits & ((UINT64_C(1) << 53) - 1)) / (double)(UINT64_C(1) << 53);
+}
+
+// ---------- Per-replication callbacks ----------
+typedef struct {
+    int rep;
+    double response_sum;
+    uint64_t responses;
+} RepState;
+
+static double on_demand(void *user, int task_id, uint64_t job_seq){
+    const RepState *rs = user;
+    const Dist *d = &dists[task_id];
+    double u = draw(task_id, job_seq, rs->rep);
+    double f;
+    if (d->kind == DIST_UNIFORM){
+        f = d->lo + (d->hi - d->lo) * u;
+    } else {
+        int b = 0;
+        while (b < d->bins - 1 && u >= d->cum[b]) b++;
+        f = d->frac[b];
+    }
+    return f > 1.0 ? 1.0 : f;
+}
+
+static void on_event(void *user, const sched_event *ev){
+    RepState *rs = user;
+    if (ev->type == SCHED_EV_COMPLETE){
+        rs->response_sum += (double)(ev->time - ev->release_time);
+        rs->responses++;
+    }
+}
+
+static bool run_rep(int rep, int mode, RepResult *out){
+    sched_ctx *ctx = sched_create(policy, NULL);
+    if (!ctx) return false;
+    for (int i = 0; i < num_tasks; ++i) sched_add_task(ctx, &tasks[i]);
+    sched_set_power(ctx, power, power_idle);
+    if (mode == 1) sched_set_freq(ctx, SCHED_FREQ_EE, 0);
+    RepState rs = { rep, 0.0, 0 };
+    sched_set_demand_callback(ctx, on_demand, &rs);
+    sched_set_event_callback(ctx, on_event, &rs);
+    int rc = sched_run_until(ctx, t_end);
+    sched_stats st;
+    sched_get_stats(ctx, &st);
+    sched_destroy(ctx);
+    out->energy = st.energy_busy + st.energy_idle;
+    out->miss_ratio = st.released ? (double)st.misses / st.released : 0.0;
+    out->mean_response = rs.responses ? rs.response_sum / rs.responses : 0.0;
+    return rc == SCHED_OK;
+}
+
+static void *worker(void *arg){
+    (void)arg;
+    for (int rep; (rep = atomic_fetch_add(&next_rep, 1)) < total_reps; ){
+        for (int m = 0; m < NUM_MODES; ++m){
+            if (!run_rep(rep, m, &results[m][rep])){
+                fprintf(stderr, "Replication %d failed\n", rep);
+                exit(1);
+            }
+        }
+    }
+    return NULL;
+}
+
+// ---------- Statistics ----------
+// Two-sided 95% Student t quantiles for 1..30 degrees of freedom.
+static const double T95[31] = { 0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+    2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+
+// Mean and 95% half-width; the sum runs in replication order so the
+// result does not depend on which thread computed what.
+static void mean_ci(const double *x, int n, double *mean, double *half){
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) sum += x[i];
+    *mean = sum / n;
+    if (n < 2){
+        *half = 0.0;
+        return;
+    }
+    double ss = 0.0;
+    for (int i = 0; i < n; ++i) ss += (x[i] - *mean) * (x[i] - *mean);
+    double t = (n - 1 <= 30) ? T95[n - 1] : 1.960;
+    *half = t * sqrt(ss / (n - 1)) / sqrt((double)n);
+}
+
+static void report(const char *label, double *col, int n){
+    double m, h;
+    mean_ci(col, n, &m, &h);
+    printf("  %-22s %14.4f  +/- %-12.4f [%.4f, %.4f]\n", label, m, h, m - h, m + h);
+}
+
+// ---------- Input ----------
+static bool load_tasks(const char *path){
+    sched_ctx *ctx = sched_create(policy, NULL);
+    int rc = ctx ? sched_load_input(ctx, path, &t_end) : SCHED_ERR_NOMEM;
+    if (rc == SCHED_OK && sched_num_tasks(ctx) > MAX_TASKS) rc = SCHED_ERR_INVAL;
+    if (rc == SCHED_OK){
+        num_tasks = sched_num_tasks(ctx);
+        for (int i = 0; i < num_tasks; ++i){
+            tasks[i] = *sched_get_task(ctx, i);
+            snprintf(task_names[i], sizeof task_names[i], "%s", tasks[i].name);
+            tasks[i].name = task_names[i];
+            dists[i] = (Dist){ .kind = DIST_UNIFORM, .lo = 0.5, .hi = 1.0 };
+        }
+        sched_get_power(ctx, power, &power_idle);
+    }
+    sched_destroy(ctx);
+    return rc == SCHED_OK;
+}
+
+static bool load_dists(const char *path){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char line[1024];
+    bool ok = true;
+    while (ok && fgets(line, sizeof line, f)){
+        char name[64], kind[16];
+        int used;
+        if (sscanf(line, "%63s %15s%n", name, kind, &used) != 2) continue;
+        int id = -1;
+        for (int i = 0; i < num_tasks; ++i) if (strcmp(task_names[i], name) == 0) id = i;
+        if (id < 0){
+            fprintf(stderr, "Unknown task %s in %s\n", name, path);
+            ok = false;
+            break;
+        }
+        Dist d = { 0 };
+        if (strcmp(kind, "uniform") == 0){
+            d.kind = DIST_UNIFORM;
+            ok = sscanf(line + used, "%lf %lf", &d.lo, &d.hi) == 2 &&
+                 d.lo > 0.0 && d.lo <= d.hi && d.hi <= 1.0;
+        } else if (strcmp(kind, "hist") == 0){
+            d.kind = DIST_HIST;
+            const char *p = line + used;
+            double total = 0.0, fr, w;
+            int n;
+            while (d.bins < MAX_BINS && sscanf(p, " %lf:%lf%n", &fr, &w, &n) == 2){
+                if (fr <= 0.0 || fr > 1.0 || w < 0.0){ ok = false; break; }
+                d.frac[d.bins] = fr;
+                total += w;
+                d.cum[d.bins++] = total;
+                p += n;
+            }
+            ok = ok && d.bins > 0 && total > 0.0;
+            for (int b = 0; ok && b < d.bins; ++b) d.cum[b] /= total;
+        } else {
+            ok = false;
+        }
+        if (!ok) fprintf(stderr, "Bad distribution for %s in %s\n", name, path);
+        dists[id] = d;
+    }
+    fclose(f);
+    return ok;
+}
+
+int main(int argc, char **argv){
+    const char *input = "test_input.txt", *dist_file = NULL;
+    int threads = 4;
+    uint64_t end = 0;
+    total_reps = 1000;
+    int k = 1;
+    if (k < argc && (strcmp(argv[k], "edf") == 0 || strcmp(argv[k], "rm") == 0)){
+        policy = (strcmp(argv[k], "edf") == 0) ? SCHED_EDF : SCHED_RM;
+        k++;
+    }
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (k + 1 >= argc) break;
+        if (strcmp(argv[k], "--reps") == 0) total_reps = atoi(argv[++k]);
+        else if (strcmp(argv[k], "--threads") == 0) threads = atoi(argv[++k]);
+        else if (strcmp(argv[k], "--seed") == 0) seed = strtoull(argv[++k], NULL, 10);
+        else if (strcmp(argv[k], "--dist") == 0) dist_file = argv[++k];
+        else if (strcmp(argv[k], "--end") == 0) end = strtoull(argv[++k], NULL, 10);
+        else break;
+    }
+    if (k < argc || total_reps < 1){
+        fprintf(stderr, "Usage: %s [edf|rm] [input_file] [--reps N] [--threads T] [--seed S] "
+                        "[--dist FILE] [--end T]\n", argv[0]);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (!load_tasks(input)){
+        fprintf(stderr, "Cannot read task set from %s\n", input);
+        return 1;
+    }
+    if (dist_file && !load_dists(dist_file)) return 1;
+    if (end) t_end = end;
+
+    for (int m = 0; m < NUM_MODES; ++m){
+        results[m] = malloc((size_t)total_reps * sizeof *results[m]);
+        if (!results[m]){
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+    }
+    atomic_init(&next_rep, 0);
+    pthread_t tid[MAX_THREADS];
+    for (int i = 0; i < threads; ++i) pthread_create(&tid[i], NULL, worker, NULL);
+    for (int i = 0; i < threads; ++i) pthread_join(tid[i], NULL);
+
+    printf("=== Monte Carlo %s: %d replications of t < %llu, seed %llu, 95%% confidence ===\n",
+           policy == SCHED_EDF ? "EDF" : "RM", total_reps, (unsigned long long)t_end,
+           (unsigned long long)seed);
+    for (int i = 0; i < num_tasks; ++i){
+        const Dist *d = &dists[i];
+        if (d->kind == DIST_UNIFORM)
+            printf("  %-8s uniform %.3f .. %.3f of WCET\n", task_names[i], d->lo, d->hi);
+        else
+            printf("  %-8s histogram, %d bins\n", task_names[i], d->bins);
+    }
+
+    double *col = malloc((size_t)total_reps * sizeof *col);
+    if (!col){
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    static const char *MODE_NAMES[NUM_MODES] = { "Fixed 1188 MHz", "EE (static level)" };
+    for (int m = 0; m < NUM_MODES; ++m){
+        printf("%s:\n", MODE_NAMES[m]);
+        for (int r = 0; r < total_reps; ++r) col[r] = results[m][r].energy;
+        report("energy", col, total_reps);
+        for (int r = 0; r < total_reps; ++r) col[r] = results[m][r].miss_ratio;
+        report("miss ratio", col, total_reps);
+        for (int r = 0; r < total_reps; ++r) col[r] = results[m][r].mean_response;
+        report("mean response time", col, total_reps);
+    }
+    printf("EE vs. fixed (paired):\n");
+    for (int r = 0; r < total_reps; ++r) col[r] = results[0][r].energy - results[1][r].energy;
+    report("energy saved", col, total_reps);
+    for (int r = 0; r < total_reps; ++r)
+        col[r] = 100.0 * (results[0][r].energy - results[1][r].energy) / results[0][r].energy;
+    report("energy saved (%)", col, total_reps);
+
+    free(col);
+    for (int m = 0; m < NUM_MODES; ++m) free(results[m]);
+    return 0;
+}
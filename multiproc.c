@@ -0,0 +1,518 @@
+// multiproc.c
+// Global scheduling of periodic tasks on m identical cores: EDF, RM, LLF,
+// EDZL and PD2 compared on misses, preemptions and migrations, for a task
+// file or as acceptance ratios over random task sets.
+// Build: gcc -O2 -std=c11 multiproc.c sched_lib.c -o multiproc -lm
+// Run:   ./multiproc [input_file] [--cores m] [--freq 0-3] [--end T]
+//        ./multiproc --random N [--cores m] [--seed S]
+//
+// Policies (the m highest-priority ready jobs run in each tick):
+//   EDF   earliest absolute deadline
+//   RM    shortest period
+//   LLF   least laxity d - t - remaining
+//   EDZL  EDF, except that jobs at zero laxity go first
+//   PD2   Pfair: unit subtasks with windows [r + floor((k-1)/w), r + ceil(k/w)),
+//         ordered by window end, b-bit and group deadline; optimal for
+//         implicit deadlines and U <= m
+//
+// Waiting jobs sit in indexed binary heaps. Laxity is never recomputed per
+// tick: a job is keyed by its zero-laxity instant d - remaining, and the
+// laxity at t is the key minus t, the same shift for every job, so the heap
+// order is the laxity order at any common epoch. A waiting job's key is
+// fixed; only the m jobs that just ran are re-keyed when they go back into
+// the heap. EDZL keeps a second heap on the same key and only looks at its
+// top to find jobs at zero laxity. PD2 keys are likewise fixed between
+// quanta, and jobs whose next subtask is not released yet wait in a heap
+// ordered by release.
+//
+// Misses are counted and late jobs dropped, as in EDF.cpp. Ties prefer the
+// job that ran in the last tick, so equal priorities do not cause
+// preemptions. A preemption is a job that ran in the last tick, is still
+// ready and does not run now. A PD2 job that stops because its next window
+// has not opened is a quantum end instead, counted in its own column
+// whether or not its core goes idle (main.c splits them the same way).
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sched_lib.h"
+
+#define MAX_TASKS  64
+#define MAX_CORES  32
+#define MAX_JOBS   1024      // live jobs
+#define NUM_POLICIES 5
+#define RANDOM_END_HYPERPERIODS 3
+
+typedef enum { POL_EDF, POL_RM, POL_LLF, POL_EDZL, POL_PD2 } Policy;
+
+static const char *POLICY_NAMES[NUM_POLICIES] = { "EDF", "RM", "LLF", "EDZL", "PD2" };
+static const int FREQUENCIES[SCHED_NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    uint32_t period, wcet, deadline, phase;
+} Task;
+
+typedef struct {
+    int task_id;
+    uint64_t release, abs_deadline, seq;
+    uint32_t remaining, executed;
+    int core;                 // core it last ran on, -1: none
+    bool running;             // ran in the last tick
+    int pos[2];               // index in each heap, -1: not in it
+} Job;
+
+typedef struct {
+    uint64_t released, completed, misses, preemptions, quantum_ends, migrations;
+} Result;
+
+static Task tasks[MAX_TASKS];
+static int num_tasks, num_cores = 2;
+static Policy policy;
+
+static Job jobs[MAX_JOBS];
+static int free_list[MAX_JOBS], num_free;
+static int live[MAX_JOBS], num_live;
+static uint64_t next_seq[MAX_TASKS];
+
+// ---------- Priorities ----------
+static inline int64_t zero_laxity_time(const Job *j){
+    return (int64_t)j->abs_deadline - (int64_t)j->remaining;
+}
+
+// PD2 window of the job's next subtask k = executed + 1
+static uint64_t pf_release(const Job *j){
+    const Task *t = &tasks[j->task_id];
+    return j->release + (uint64_t)j->executed * t->period / t->wcet;
+}
+static uint64_t pf_deadline(const Job *j){
+    const Task *t = &tasks[j->task_id];
+    uint64_t k = j->executed + 1;
+    return j->release + (k * t->period + t->wcet - 1) / t->wcet;
+}
+static int pf_bbit(const Job *j){
+    const Task *t = &tasks[j->task_id];
+    return ((uint64_t)(j->executed + 1) * t->period % t->wcet) != 0;
+}
+// Heavy tasks (w >= 1/2): ceil(ceil(d (1 - w)) / (1 - w)); 0 for light ones.
+static uint64_t pf_group_deadline(const Job *j){
+    const Task *t = &tasks[j->task_id];
+    if (2 * (uint64_t)t->wcet < t->period) return 0;
+    if (t->wcet >= t->period) return UINT64_MAX;
+    uint64_t T = t->period, idle = T - t->wcet;
+    uint64_t d = pf_deadline(j) - j->release;
+    uint64_t x = (d * idle + T - 1) / T;
+    return j->release + (x * T + idle - 1) / idle;
+}
+
+// Final ties: the job that ran last, then task and job order.
+static bool tie_before(const Job *a, const Job *b){
+    if (a->running != b->running) return a->running;
+    if (a->abs_deadline != b->abs_deadline) return a->abs_deadline < b->abs_deadline;
+    if (a->task_id != b->task_id) return a->task_id < b->task_id;
+    return a->seq < b->seq;
+}
+
+// Ready order of the policy (heap 0)
+static bool ready_before(int x, int y){
+    const Job *a = &jobs[x], *b = &jobs[y];
+    switch (policy){
+    case POL_EDF:
+    case POL_EDZL:
+        if (a->abs_deadline != b->abs_deadline) return a->abs_deadline < b->abs_deadline;
+        break;
+    case POL_RM: {
+        uint32_t pa = tasks[a->task_id].period, pb = tasks[b->task_id].period;
+        if (pa != pb) return pa < pb;
+        break;
+    }
+    case POL_LLF: {
+        int64_t la = zero_laxity_time(a), lb = zero_laxity_time(b);
+        if (la != lb) return la < lb;
+        break;
+    }
+    case POL_PD2: {
+        uint64_t da = pf_deadline(a), db = pf_deadline(b);
+        if (da != db) return da < db;
+        int ba = pf_bbit(a), bb = pf_bbit(b);
+        if (ba != bb) return ba > bb;
+        uint64_t ga = pf_group_deadline(a), gb = pf_group_deadline(b);
+        if (ga != gb) return ga > gb;
+        break;
+    }
+    }
+    return tie_before(a, b);
+}
+
+// Heap 1: EDZL laxity order, PD2 pending subtasks by release
+static bool aux_before(int x, int y){
+    const Job *a = &jobs[x], *b = &jobs[y];
+    if (policy == POL_EDZL){
+        int64_t la = zero_laxity_time(a), lb = zero_laxity_time(b);
+        if (la != lb) return la < lb;
+    } else {
+        uint64_t ra = pf_release(a), rb = pf_release(b);
+        if (ra != rb) return ra < rb;
+    }
+    return tie_before(a, b);
+}
+
+// ---------- Indexed binary heaps ----------
+typedef struct {
+    int items[MAX_JOBS];
+    int size;
+    int which;                        // slot in Job.pos
+    bool (*before)(int, int);
+} Heap;
+
+static Heap ready_heap = { .which = 0, .before = ready_before };
+static Heap aux_heap   = { .which = 1, .before = aux_before };
+
+static void heap_set(Heap *h, int i, int job){
+    h->items[i] = job;
+    jobs[job].pos[h->which] = i;
+}
+
+static void heap_sift_up(Heap *h, int i){
+    int job = h->items[i];
+    while (i > 0){
+        int parent = (i - 1) / 2;
+        if (!h->before(job, h->items[parent])) break;
+        heap_set(h, i, h->items[parent]);
+        i = parent;
+    }
+    heap_set(h, i, job);
+}
+
+static void heap_sift_down(Heap *h, int i){
+    int job = h->items[i];
+    for (;;){
+        int c = 2 * i + 1;
+        if (c >= h->size) break;
+        if (c + 1 < h->size && h->before(h->items[c + 1], h->items[c])) c++;
+        if (!h->before(h->items[c], job)) break;
+        heap_set(h, i, h->items[c]);
+        i = c;
+    }
+    heap_set(h, i, job);
+}
+
+static void heap_push(Heap *h, int job){
+    heap_set(h, h->size++, job);
+    heap_sift_up(h, h->size - 1);
+}
+
+static void heap_remove(Heap *h, int job){
+    int i = jobs[job].pos[h->which];
+    if (i < 0) return;
+    jobs[job].pos[h->which] = -1;
+    int last = h->items[--h->size];
+    if (i == h->size) return;
+    heap_set(h, i, last);
+    heap_sift_up(h, i);
+    heap_sift_down(h, jobs[last].pos[h->which]);
+}
+
+static int heap_top(const Heap *h){ return h->size ? h->items[0] : -1; }
+
+// Puts a job that is not running into the heaps its policy uses.
+static void enqueue(int j, uint64_t t){
+    if (policy == POL_PD2 && pf_release(&jobs[j]) > t) heap_push(&aux_heap, j);
+    else heap_push(&ready_heap, j);
+    if (policy == POL_EDZL) heap_push(&aux_heap, j);
+}
+
+static void dequeue(int j){
+    heap_remove(&ready_heap, j);
+    heap_remove(&aux_heap, j);
+}
+
+// ---------- Simulation ----------
+static void job_free(int j, int live_idx){
+    dequeue(j);
+    live[live_idx] = live[--num_live];
+    free_list[num_free++] = j;
+}
+
+static bool simulate(Policy pol, uint64_t end, Result *res){
+    policy = pol;
+    memset(res, 0, sizeof *res);
+    memset(next_seq, 0, sizeof next_seq);
+    ready_heap.size = aux_heap.size = 0;
+    num_free = num_live = 0;
+    for (int j = MAX_JOBS - 1; j >= 0; --j) free_list[num_free++] = j;
+    int run[MAX_CORES], num_run = 0;      // jobs that ran in the last tick
+    int core_of[MAX_CORES];
+
+    for (uint64_t t = 0; t <= end; ++t){
+        // 1) Releases
+        for (int i = 0; i < num_tasks; ++i){
+            const Task *ti = &tasks[i];
+            if (t < ti->phase || (t - ti->phase) % ti->period != 0) continue;
+            if (num_free == 0){
+                fprintf(stderr, "Too many live jobs; dropping release!\n");
+                return false;
+            }
+            int j = free_list[--num_free];
+            Job *x = &jobs[j];
+            x->task_id = i;
+            x->release = t;
+            x->abs_deadline = t + ti->deadline;
+            x->seq = next_seq[i]++;
+            x->remaining = ti->wcet;
+            x->executed = 0;
+            x->core = -1;
+            x->running = false;
+            x->pos[0] = x->pos[1] = -1;
+            live[num_live++] = j;
+            enqueue(j, t);
+            res->released++;
+        }
+
+        // 2) PD2: subtasks whose window opens now become ready
+        if (policy == POL_PD2){
+            int j;
+            while ((j = heap_top(&aux_heap)) >= 0 && pf_release(&jobs[j]) <= t){
+                heap_remove(&aux_heap, j);
+                heap_push(&ready_heap, j);
+            }
+        }
+
+        // 3) Deadline misses: late jobs are dropped
+        for (int k = 0; k < num_live; ++k){
+            int j = live[k];
+            if (t > jobs[j].abs_deadline){
+                res->misses++;
+                for (int r = 0; r < num_run; ++r) if (run[r] == j) run[r] = -1;
+                job_free(j, k--);
+            }
+        }
+
+        // 4) Pick up to m jobs
+        int pick[MAX_CORES], np = 0;
+        if (policy == POL_EDZL){
+            int j;
+            while (np < num_cores && (j = heap_top(&aux_heap)) >= 0 &&
+                   zero_laxity_time(&jobs[j]) <= (int64_t)t){
+                dequeue(j);
+                pick[np++] = j;
+            }
+        }
+        while (np < num_cores && ready_heap.size > 0){
+            int j = heap_top(&ready_heap);
+            dequeue(j);
+            pick[np++] = j;
+        }
+
+        // 5) Cores: jobs that keep running keep their core
+        bool taken[MAX_CORES] = { false };
+        for (int k = 0; k < np; ++k){
+            core_of[k] = -1;
+            if (jobs[pick[k]].running){
+                core_of[k] = jobs[pick[k]].core;
+                taken[core_of[k]] = true;
+            }
+        }
+        for (int r = 0; r < num_run; ++r){
+            int j = run[r];
+            if (j < 0 || (jobs[j].pos[0] < 0 && jobs[j].pos[1] < 0)) continue;   // picked or gone
+            if (policy == POL_PD2 && jobs[j].pos[1] >= 0) res->quantum_ends++;   // window not open
+            else res->preemptions++;
+            dequeue(j);              // its tie-break changes
+            jobs[j].running = false;
+            enqueue(j, t);
+        }
+        int next_free = 0;
+        for (int k = 0; k < np; ++k){
+            Job *x = &jobs[pick[k]];
+            if (core_of[k] < 0){
+                while (taken[next_free]) next_free++;
+                taken[next_free] = true;
+                core_of[k] = next_free;
+                if (x->core >= 0 && x->core != core_of[k]) res->migrations++;
+            }
+            x->core = core_of[k];
+        }
+
+        // 6) Execute one tick
+        num_run = 0;
+        for (int k = 0; k < np; ++k){
+            int j = pick[k];
+            Job *x = &jobs[j];
+            x->remaining--;
+            x->executed++;
+            if (x->remaining == 0){
+                res->completed++;
+                for (int l = 0; l < num_live; ++l) if (live[l] == j){ job_free(j, l); break; }
+                continue;
+            }
+            x->running = true;
+            enqueue(j, t + 1);   // re-keyed: its laxity or subtask changed
+            run[num_run++] = j;
+        }
+    }
+    return true;
+}
+
+// ---------- Task sets ----------
+static bool load_tasks(const char *path, int level, uint64_t *t_end){
+    sched_ctx *ctx = sched_create(SCHED_EDF, NULL);
+    int rc = ctx ? sched_load_input(ctx, path, t_end) : SCHED_ERR_NOMEM;
+    if (rc == SCHED_OK && sched_num_tasks(ctx) > MAX_TASKS) rc = SCHED_ERR_INVAL;
+    if (rc == SCHED_OK){
+        num_tasks = sched_num_tasks(ctx);
+        for (int i = 0; i < num_tasks; ++i){
+            const sched_task *s = sched_get_task(ctx, i);
+            tasks[i] = (Task){ s->period, s->wcet[level], s->deadline ? s->deadline : s->period,
+                               s->phase };
+            if (tasks[i].wcet > tasks[i].period) rc = SCHED_ERR_INVAL;   // needs two cores at once
+        }
+    }
+    sched_destroy(ctx);
+    return rc == SCHED_OK;
+}
+
+static uint64_t rng_state = 20240601;
+static uint64_t rng_next(void){
+    uint64_t x = rng_state;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    rng_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+static double rng_unit(void){ return (rng_next() >> 11) * (1.0 / 9007199254740992.0); }
+
+// UUniFast-discard: n utilizations summing to u, none above 1. Periods
+// divide 200, so the hyperperiod stays short.
+static void random_tasks(int n, double u){
+    static const uint32_t PERIODS[] = { 10, 20, 25, 40, 50, 100, 200 };
+    double util[MAX_TASKS];
+    for (;;){
+        double sum = u;
+        bool ok = true;
+        for (int i = 0; i < n - 1; ++i){
+            double next = sum * pow(rng_unit(), 1.0 / (n - 1 - i));
+            util[i] = sum - next;
+            sum = next;
+        }
+        util[n - 1] = sum;
+        for (int i = 0; i < n; ++i) ok = ok && util[i] <= 1.0;
+        if (ok) break;
+    }
+    num_tasks = n;
+    for (int i = 0; i < n; ++i){
+        uint32_t T = PERIODS[rng_next() % (sizeof PERIODS / sizeof PERIODS[0])];
+        uint32_t C = (uint32_t)lround(util[i] * T);
+        if (C < 1) C = 1;
+        if (C > T) C = T;
+        tasks[i] = (Task){ T, C, T, 0 };
+    }
+}
+
+static double total_utilization(void){
+    double u = 0.0;
+    for (int i = 0; i < num_tasks; ++i) u += (double)tasks[i].wcet / tasks[i].period;
+    return u;
+}
+
+int main(int argc, char **argv){
+    const char *input = "test_input.txt";
+    int level = 0, random_sets = 0;
+    uint64_t end = 0, t_end = 0;
+    int k = 1;
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--cores") == 0 && k + 1 < argc){
+            num_cores = atoi(argv[++k]);
+            if (num_cores < 1 || num_cores > MAX_CORES) break;
+        } else if (strcmp(argv[k], "--freq") == 0 && k + 1 < argc){
+            level = atoi(argv[++k]);
+            if (level < 0 || level >= SCHED_NUM_FREQS) break;
+        } else if (strcmp(argv[k], "--end") == 0 && k + 1 < argc){
+            end = strtoull(argv[++k], NULL, 10);
+        } else if (strcmp(argv[k], "--random") == 0 && k + 1 < argc){
+            random_sets = atoi(argv[++k]);
+            if (random_sets < 1) break;
+        } else if (strcmp(argv[k], "--seed") == 0 && k + 1 < argc){
+            rng_state = strtoull(argv[++k], NULL, 10) | 1;
+        } else {
+            break;
+        }
+    }
+    if (k < argc){
+        fprintf(stderr, "Usage: %s [input_file] [--cores m] [--freq 0-3] [--end T]\n"
+                        "       %s --random N [--cores m] [--seed S]\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    Result res;
+    if (!random_sets){
+        if (!load_tasks(input, level, &t_end)){
+            fprintf(stderr, "Cannot read task set from %s\n", input);
+            return 1;
+        }
+        if (end) t_end = end;
+        double u = total_utilization();
+        printf("=== Global scheduling on %d cores @ %d MHz, t <= %llu ===\n", num_cores,
+               FREQUENCIES[level], (unsigned long long)t_end);
+        printf("Task set: n=%d, U=%.4f (U/m=%.4f)\n", num_tasks, u, u / num_cores);
+        printf("  %-6s %9s %9s %8s %12s %11s %12s %13s\n", "policy", "released", "completed",
+               "misses", "preemptions", "migrations", "preempt/job", "quantum ends");
+        for (int p = 0; p < NUM_POLICIES; ++p){
+            if (!simulate((Policy)p, t_end, &res)) return 1;
+            printf("  %-6s %9llu %9llu %8llu %12llu %11llu %12.3f", POLICY_NAMES[p],
+                   (unsigned long long)res.released, (unsigned long long)res.completed,
+                   (unsigned long long)res.misses, (unsigned long long)res.preemptions,
+                   (unsigned long long)res.migrations,
+                   res.completed ? (double)res.preemptions / res.completed : 0.0);
+            if (p == POL_PD2) printf(" %13llu\n", (unsigned long long)res.quantum_ends);
+            else printf(" %13s\n", "-");
+        }
+        return 0;
+    }
+
+    int n = 3 * num_cores;
+    if (n > MAX_TASKS) n = MAX_TASKS;
+    uint64_t horizon = 200 * RANDOM_END_HYPERPERIODS;
+    printf("=== Acceptance ratio: %d random sets of %d tasks per point on %d cores, "
+           "t <= %llu ===\n", random_sets, n, num_cores, (unsigned long long)horizon);
+    printf("  %-6s", "U/m");
+    for (int p = 0; p < NUM_POLICIES; ++p) printf(" %8s", POLICY_NAMES[p]);
+    printf("   (preemptions per job)\n");
+    double total_pre[NUM_POLICIES] = { 0 }, total_quanta = 0.0;
+    int feasible = 0, pd2_feasible_misses = 0;   // rounding may push U above m
+    for (int step = 10; step <= 20; ++step){
+        double target = step * 0.05;
+        int ok[NUM_POLICIES] = { 0 };
+        double pre[NUM_POLICIES] = { 0 };
+        for (int s = 0; s < random_sets; ++s){
+            random_tasks(n, target * num_cores);
+            bool fits = total_utilization() <= num_cores + 1e-9;
+            feasible += fits;
+            for (int p = 0; p < NUM_POLICIES; ++p){
+                if (!simulate((Policy)p, horizon, &res)) return 1;
+                ok[p] += res.misses == 0;
+                if (p == POL_PD2 && fits && res.misses) pd2_feasible_misses++;
+                pre[p] += res.completed ? (double)res.preemptions / res.completed : 0.0;
+                if (p == POL_PD2 && res.completed)
+                    total_quanta += (double)res.quantum_ends / res.completed;
+            }
+        }
+        printf("  %-6.2f", target);
+        for (int p = 0; p < NUM_POLICIES; ++p) printf(" %7.1f%%", 100.0 * ok[p] / random_sets);
+        printf("  ");
+        for (int p = 0; p < NUM_POLICIES; ++p){
+            printf(" %.2f", pre[p] / random_sets);
+            total_pre[p] += pre[p] / random_sets;
+        }
+        printf("\n");
+    }
+    printf("Mean preemptions per job:");
+    for (int p = 0; p < NUM_POLICIES; ++p) printf(" %s %.3f", POLICY_NAMES[p], total_pre[p] / 11);
+    printf("\n");
+    printf("PD2 quantum ends per job (not counted as preemptions): %.3f\n",
+           total_quanta / (11.0 * random_sets));
+    printf("PD2 sets with misses among %d sets with U <= m: %d\n", feasible, pd2_feasible_misses);
+    return pd2_feasible_misses ? 1 : 0;
+}
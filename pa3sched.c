@@ -0,0 +1,384 @@
+// pa3sched.c
+// Python bindings for libsched, used by PA3.py.
+// Build: gcc -O2 -std=c11 -shared -fPIC $(python3-config --includes) pa3sched.c sched_lib.c
+//            -o pa3sched$(python3-config --extension-suffix) -lm      (one command line)
+//
+//   import array, pa3sched
+//   r = pa3sched.simulate(array.array('I', periods),      # n periods
+//                         array.array('I', wcets),        # n x 4 WCETs, row-major
+//                         policy="EDF", ee=True, t_end=1000,
+//                         power=(625, 447, 307, 212), idle_power=84)
+//   r["finish"], r["energy"], ...   # per-job columns, buffer protocol
+//   r["stats"]                      # summary counters
+//
+// Task sets come in as contiguous uint32 buffers (array.array('I'), numpy
+// uint32, ...). Per-job results come back as JobArray objects that export
+// their C storage through the buffer protocol, so memoryview() or
+// numpy.frombuffer() read them without a copy. The GIL is released while the
+// engine runs, so Python threads can simulate many task sets at once.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_lib.h"
+
+// ---------- JobArray: a column of per-job results ----------
+typedef struct {
+    PyObject_HEAD
+    void *data;
+    Py_ssize_t len;
+    Py_ssize_t itemsize;
+    const char *format;     // struct-module format of one item
+    Py_ssize_t shape[1];
+} JobArray;
+
+static int JobArray_getbuffer(PyObject *obj, Py_buffer *view, int flags){
+    JobArray *self = (JobArray *)obj;
+    if (PyBuffer_FillInfo(view, obj, self->data, self->len * self->itemsize, 1, flags) < 0)
+        return -1;
+    view->itemsize = self->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? (char *)self->format : NULL;
+    view->ndim = 1;
+    self->shape[0] = self->len;
+    view->shape = (flags & PyBUF_ND) ? self->shape : NULL;
+    return 0;
+}
+
+static void JobArray_dealloc(PyObject *obj){
+    free(((JobArray *)obj)->data);
+    Py_TYPE(obj)->tp_free(obj);
+}
+
+static Py_ssize_t JobArray_length(PyObject *obj){
+    return ((JobArray *)obj)->len;
+}
+
+// Exported views hold a reference to the JobArray, so the storage outlives them.
+static PyBufferProcs JobArray_as_buffer = {
+    JobArray_getbuffer,
+    NULL,
+};
+
+static PySequenceMethods JobArray_as_sequence = {
+    .sq_length = JobArray_length,
+};
+
+static PyTypeObject JobArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "pa3sched.JobArray",
+    .tp_doc = "Per-job result column exported through the buffer protocol.",
+    .tp_basicsize = sizeof(JobArray),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_dealloc = JobArray_dealloc,
+    .tp_as_buffer = &JobArray_as_buffer,
+    .tp_as_sequence = &JobArray_as_sequence,
+};
+
+// Takes ownership of data (malloc'd).
+static PyObject *job_array_new(void *data, Py_ssize_t len, Py_ssize_t itemsize, const char *format){
+    JobArray *a = PyObject_New(JobArray, &JobArrayType);
+    if (!a){
+        free(data);
+        return NULL;
+    }
+    a->data = data;
+    a->len = len;
+    a->itemsize = itemsize;
+    a->format = format;
+    return (PyObject *)a;
+}
+
+// ---------- Collecting per-job results (runs without the GIL) ----------
+typedef struct {
+    int32_t *task;
+    uint64_t *job, *release, *start, *finish;
+    int32_t *freq;
+    double *energy;
+    uint8_t *missed;
+    size_t rows, cap;
+
+    int64_t **row_of;         // row_of[task][seq]
+    size_t *row_cap;
+    int ntasks;
+
+    const double *power;      // active power per level
+    int64_t running;          // row of the running job, -1 if idle
+    uint64_t since;           // when it got the CPU
+    bool nomem;
+} Collector;
+
+static bool grow(void **p, size_t n, size_t elem){
+    void *q = realloc(*p, n * elem);
+    if (!q) return false;
+    *p = q;
+    return true;
+}
+
+static bool collector_add_row(Collector *c, const sched_event *ev){
+    if (c->rows == c->cap){
+        size_t n = c->cap ? c->cap * 2 : 1024;
+        if (!grow((void **)&c->task, n, sizeof *c->task) ||
+            !grow((void **)&c->job, n, sizeof *c->job) ||
+            !grow((void **)&c->release, n, sizeof *c->release) ||
+            !grow((void **)&c->start, n, sizeof *c->start) ||
+            !grow((void **)&c->finish, n, sizeof *c->finish) ||
+            !grow((void **)&c->freq, n, sizeof *c->freq) ||
+            !grow((void **)&c->energy, n, sizeof *c->energy) ||
+            !grow((void **)&c->missed, n, sizeof *c->missed)) return false;
+        c->cap = n;
+    }
+    int t = ev->task_id;
+    if (ev->job_seq >= c->row_cap[t]){
+        size_t n = c->row_cap[t] ? c->row_cap[t] * 2 : 64;
+        while (n <= ev->job_seq) n *= 2;
+        if (!grow((void **)&c->row_of[t], n, sizeof **c->row_of)) return false;
+        c->row_cap[t] = n;
+    }
+    size_t r = c->rows++;
+    c->row_of[t][ev->job_seq] = (int64_t)r;
+    c->task[r] = t;
+    c->job[r] = ev->job_seq;
+    c->release[r] = ev->release_time;
+    c->start[r] = UINT64_MAX;
+    c->finish[r] = UINT64_MAX;
+    c->freq[r] = -1;
+    c->energy[r] = 0.0;
+    c->missed[r] = 0;
+    return true;
+}
+
+// Charges the running job for the ticks since it got the CPU.
+static void collector_stop(Collector *c, uint64_t t, int freq){
+    if (c->running < 0) return;
+    c->energy[c->running] += (double)(t - c->since) * c->power[freq];
+    c->running = -1;
+}
+
+static void collector_run(Collector *c, const sched_event *ev){
+    int64_t r = c->row_of[ev->task_id][ev->job_seq];
+    c->running = r;
+    c->since = ev->time;
+    if (c->start[r] == UINT64_MAX) c->start[r] = ev->time;
+    c->freq[r] = ev->freq;
+}
+
+static void on_event(void *user, const sched_event *ev){
+    Collector *c = user;
+    if (c->nomem) return;
+    switch (ev->type){
+    case SCHED_EV_RELEASE:
+        if (!collector_add_row(c, ev)) c->nomem = true;
+        break;
+    case SCHED_EV_START:
+        collector_run(c, ev);
+        break;
+    case SCHED_EV_PREEMPT:
+        collector_stop(c, ev->time, ev->freq);
+        collector_run(c, ev);
+        break;
+    case SCHED_EV_COMPLETE: {
+        int64_t r = c->row_of[ev->task_id][ev->job_seq];
+        collector_stop(c, ev->time, ev->freq);
+        c->finish[r] = ev->time;
+        break;
+    }
+    case SCHED_EV_MISS: {
+        int64_t r = c->row_of[ev->task_id][ev->job_seq];
+        if (r == c->running) collector_stop(c, ev->time, ev->freq);
+        c->finish[r] = ev->time;
+        c->missed[r] = 1;
+        break;
+    }
+    case SCHED_EV_FREQ:
+        // The running job is charged at the old level up to now.
+        if (c->running >= 0){
+            int64_t r = c->running;
+            collector_stop(c, ev->time, c->freq[r]);
+            c->running = r;
+            c->since = ev->time;
+            c->freq[r] = ev->freq;
+        }
+        break;
+    case SCHED_EV_SLEEP:
+    case SCHED_EV_WAKE:
+        break;   // only happen while no job runs
+    }
+}
+
+static void collector_free(Collector *c){
+    free(c->task); free(c->job); free(c->release); free(c->start);
+    free(c->finish); free(c->freq); free(c->energy); free(c->missed);
+    for (int i = 0; i < c->ntasks; ++i) free(c->row_of[i]);
+    free(c->row_of);
+    free(c->row_cap);
+}
+
+// ---------- simulate() ----------
+// Borrows a C-contiguous buffer of native uint32 ("I") with `want` items.
+static int get_u32(PyObject *obj, Py_buffer *view, Py_ssize_t want, const char *what){
+    if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) return -1;
+    const char *fmt = view->format ? view->format : "B";
+    if (*fmt == '@' || *fmt == '=') fmt++;
+    if (view->itemsize != 4 || (strcmp(fmt, "I") != 0 && strcmp(fmt, "L") != 0)){
+        PyErr_Format(PyExc_TypeError, "%s must be a contiguous uint32 buffer", what);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    if (view->len / 4 != want){
+        PyErr_Format(PyExc_ValueError, "%s has %zd items, expected %zd", what, view->len / 4, want);
+        PyBuffer_Release(view);
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *stats_dict(const sched_stats *s){
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:d,s:d,s:(KKKK)}",
+        "now", (unsigned long long)s->now,
+        "released", (unsigned long long)s->released,
+        "completed", (unsigned long long)s->completed,
+        "preemptions", (unsigned long long)s->preemptions,
+        "misses", (unsigned long long)s->misses,
+        "busy_ticks", (unsigned long long)s->busy_ticks,
+        "idle_ticks", (unsigned long long)s->idle_ticks,
+        "energy_busy", s->energy_busy,
+        "energy_idle", s->energy_idle,
+        "freq_ticks", (unsigned long long)s->freq_ticks[0], (unsigned long long)s->freq_ticks[1],
+                      (unsigned long long)s->freq_ticks[2], (unsigned long long)s->freq_ticks[3]);
+}
+
+static PyObject *simulate(PyObject *self, PyObject *args, PyObject *kw){
+    (void)self;
+    static char *kwlist[] = {"periods", "wcets", "policy", "ee", "t_end", "power",
+                             "idle_power", "freq", "deadlines", "phases", NULL};
+    PyObject *periods_obj, *wcets_obj, *deadlines_obj = Py_None, *phases_obj = Py_None;
+    const char *policy = "EDF";
+    int ee = 0, freq = 0;
+    unsigned long long t_end = 1000;
+    double power[SCHED_NUM_FREQS] = {0, 0, 0, 0}, idle = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kw, "OO|spK(dddd)diOO", kwlist,
+                                     &periods_obj, &wcets_obj, &policy, &ee, &t_end,
+                                     &power[0], &power[1], &power[2], &power[3],
+                                     &idle, &freq, &deadlines_obj, &phases_obj))
+        return NULL;
+
+    sched_policy pol;
+    if (strcmp(policy, "EDF") == 0 || strcmp(policy, "edf") == 0) pol = SCHED_EDF;
+    else if (strcmp(policy, "RM") == 0 || strcmp(policy, "rm") == 0) pol = SCHED_RM;
+    else return PyErr_Format(PyExc_ValueError, "policy must be 'EDF' or 'RM'");
+
+    Py_buffer pv, wv, dv = {0}, phv = {0};
+    if (PyObject_GetBuffer(periods_obj, &pv, PyBUF_SIMPLE) < 0) return NULL;
+    Py_ssize_t n = pv.len / 4;
+    PyBuffer_Release(&pv);
+    if (get_u32(periods_obj, &pv, n, "periods") < 0) return NULL;
+    if (get_u32(wcets_obj, &wv, n * SCHED_NUM_FREQS, "wcets") < 0){
+        PyBuffer_Release(&pv);
+        return NULL;
+    }
+    bool has_d = deadlines_obj != Py_None, has_ph = phases_obj != Py_None;
+    if ((has_d && get_u32(deadlines_obj, &dv, n, "deadlines") < 0) ||
+        (has_ph && get_u32(phases_obj, &phv, n, "phases") < 0)){
+        if (has_d && dv.obj) PyBuffer_Release(&dv);
+        PyBuffer_Release(&pv);
+        PyBuffer_Release(&wv);
+        return NULL;
+    }
+
+    sched_ctx *ctx = sched_create(pol, NULL);
+    Collector c;
+    memset(&c, 0, sizeof c);
+    c.ntasks = (int)n;
+    c.row_of = calloc((size_t)n + 1, sizeof *c.row_of);
+    c.row_cap = calloc((size_t)n + 1, sizeof *c.row_cap);
+    c.power = power;
+    c.running = -1;
+    int rc = (ctx && c.row_of && c.row_cap) ? SCHED_OK : SCHED_ERR_NOMEM;
+
+    const uint32_t *P = pv.buf, *W = wv.buf, *D = dv.buf, *PH = phv.buf;
+    for (Py_ssize_t i = 0; rc == SCHED_OK && i < n; ++i){
+        char name[32];
+        snprintf(name, sizeof name, "T%zd", i + 1);
+        sched_task t = { name, P[i], {W[4 * i], W[4 * i + 1], W[4 * i + 2], W[4 * i + 3]},
+                         has_d ? D[i] : 0, has_ph ? PH[i] : 0 };
+        int id = sched_add_task(ctx, &t);
+        if (id < 0) rc = id;
+    }
+    PyBuffer_Release(&pv);
+    PyBuffer_Release(&wv);
+    if (has_d) PyBuffer_Release(&dv);
+    if (has_ph) PyBuffer_Release(&phv);
+
+    if (rc == SCHED_OK){
+        sched_set_power(ctx, power, idle);
+        rc = sched_set_freq(ctx, ee ? SCHED_FREQ_EE : SCHED_FREQ_FIXED, freq);
+    }
+    sched_stats st = {0};
+    if (rc == SCHED_OK){
+        sched_set_event_callback(ctx, on_event, &c);
+        Py_BEGIN_ALLOW_THREADS
+        rc = sched_run_until(ctx, t_end);
+        sched_get_stats(ctx, &st);
+        // The job still running at the end gets no further event.
+        collector_stop(&c, st.now, sched_current_freq(ctx));
+        Py_END_ALLOW_THREADS
+        if (rc == SCHED_OK && c.nomem) rc = SCHED_ERR_NOMEM;
+    }
+    sched_destroy(ctx);
+    if (rc != SCHED_OK){
+        collector_free(&c);
+        if (rc == SCHED_ERR_NOMEM) return PyErr_NoMemory();
+        return PyErr_Format(PyExc_ValueError, "invalid task set: %s", sched_strerror(rc));
+    }
+
+    // Hand the column storage over to JobArray objects.
+    Py_ssize_t rows = (Py_ssize_t)c.rows;
+    PyObject *res = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N,s:N,s:N,s:N,s:N}",
+        "task",    job_array_new(c.task, rows, 4, "i"),
+        "job",     job_array_new(c.job, rows, 8, "Q"),
+        "release", job_array_new(c.release, rows, 8, "Q"),
+        "start",   job_array_new(c.start, rows, 8, "Q"),
+        "finish",  job_array_new(c.finish, rows, 8, "Q"),
+        "freq",    job_array_new(c.freq, rows, 4, "i"),
+        "energy",  job_array_new(c.energy, rows, 8, "d"),
+        "missed",  job_array_new(c.missed, rows, 1, "B"),
+        "stats",   stats_dict(&st));
+    c.task = NULL; c.job = c.release = c.start = c.finish = NULL;
+    c.freq = NULL; c.energy = NULL; c.missed = NULL;
+    collector_free(&c);
+    return res;
+}
+
+static PyMethodDef methods[] = {
+    {"simulate", (PyCFunction)(void (*)(void))simulate, METH_VARARGS | METH_KEYWORDS,
+     "simulate(periods, wcets, policy='EDF', ee=False, t_end=1000, power=(0,0,0,0),\n"
+     "         idle_power=0.0, freq=0, deadlines=None, phases=None) -> dict\n\n"
+     "Runs the EDF/RM engine for ticks [0, t_end). Per-job columns (task, job,\n"
+     "release, start, finish, freq, energy, missed) are JobArray buffers;\n"
+     "start/finish are 2**64-1 for jobs that never started/finished."},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef module = {
+    PyModuleDef_HEAD_INIT, "pa3sched",
+    "Native EDF/RM/EE scheduling engine (libsched) for PA3.py.", -1, methods,
+    NULL, NULL, NULL, NULL,
+};
+
+PyMODINIT_FUNC PyInit_pa3sched(void){
+    if (PyType_Ready(&JobArrayType) < 0) return NULL;
+    PyObject *m = PyModule_Create(&module);
+    if (!m) return NULL;
+    Py_INCREF(&JobArrayType);
+    if (PyModule_AddObject(m, "JobArray", (PyObject *)&JobArrayType) < 0){
+        Py_DECREF(&JobArrayType);
+        Py_DECREF(m);
+        return NULL;
+    }
+    PyModule_AddIntConstant(m, "NUM_FREQS", SCHED_NUM_FREQS);
+    return m;
+}
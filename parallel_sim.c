@@ -0,0 +1,354 @@
+// parallel_sim.c
+// Time-parallel simulation of one long horizon on libsched: the horizon is
+// cut at predicted idle instants, the segments run concurrently, and the
+// results are stitched together with verification.
+// Build: gcc -O2 -std=c11 -pthread parallel_sim.c sched_lib.c -o parallel_sim -lm
+// Run:   ./parallel_sim [edf|rm] [input_file] [--end T] [--threads N] [--segments S]
+//                       [--ee] [--verify]
+//
+// At an idle instant (no job running or pending at the start of a tick) the
+// schedule state depends on the time alone, so a segment can start there
+// with sched_seek_idle() without simulating what came before.
+//
+// Boundaries: the even split points are snapped to a multiple of the
+// hyperperiod when it is shorter than a segment, then a short probe run
+// (started idle a few periods earlier) picks the nearest instant at which
+// it is idle. That is only a prediction, since the probe does not know the
+// backlog it started without.
+//
+// Stitching walks the segments in order. If the previous segment really is
+// idle at the boundary, the next segment's result is exact and is taken as
+// is. Otherwise the true schedule is continued from the boundary in
+// lockstep with a replay of the speculative one until both are idle at the
+// same instant; from there on they are identical, so only that stretch is
+// re-simulated and the speculative run's remainder is kept. If they never
+// meet inside the segment, the continuation replaces the segment.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "sched_lib.h"
+
+#define MAX_TASKS    256
+#define MAX_SEGMENTS 1024
+#define MAX_THREADS  64
+
+static sched_policy policy = SCHED_EDF;
+static bool ee = false;
+static sched_task tasks[MAX_TASKS];
+static char task_names[MAX_TASKS][64];
+static int num_tasks;
+static double power[SCHED_NUM_FREQS], power_idle;
+
+typedef struct {
+    uint64_t begin, end;       // [begin, end)
+    sched_ctx *ctx;            // speculative run, left at `end`
+    sched_stats stats;         // of [begin, end)
+    uint64_t redone;           // ticks re-simulated while stitching
+    bool exact;                // begin turned out to be an idle instant
+} Segment;
+
+static Segment segs[MAX_SEGMENTS];
+static int num_segs;
+static atomic_int next_seg;
+static atomic_bool failed;
+
+static sched_ctx *new_ctx(void){
+    sched_ctx *ctx = sched_create(policy, NULL);
+    if (!ctx) return NULL;
+    for (int i = 0; i < num_tasks; ++i) sched_add_task(ctx, &tasks[i]);
+    sched_set_power(ctx, power, power_idle);
+    if (ee) sched_set_freq(ctx, SCHED_FREQ_EE, 0);
+    return ctx;
+}
+
+// *dst += *a - *b for every counter (stats of one run at two instants, or
+// of two runs that agree from some instant on).
+static void stats_add_diff(sched_stats *dst, const sched_stats *a, const sched_stats *b){
+    dst->released += a->released - b->released;
+    dst->completed += a->completed - b->completed;
+    dst->preemptions += a->preemptions - b->preemptions;
+    dst->misses += a->misses - b->misses;
+    dst->busy_ticks += a->busy_ticks - b->busy_ticks;
+    dst->idle_ticks += a->idle_ticks - b->idle_ticks;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f) dst->freq_ticks[f] += a->freq_ticks[f] - b->freq_ticks[f];
+    dst->energy_busy += a->energy_busy - b->energy_busy;
+    dst->energy_idle += a->energy_idle - b->energy_idle;
+}
+
+static double now_sec(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---------- Boundary prediction ----------
+static uint64_t gcd_u64(uint64_t a, uint64_t b){
+    while (b){ uint64_t r = a % b; a = b; b = r; }
+    return a;
+}
+
+// 0 when it does not fit comfortably in 64 bits
+static uint64_t hyperperiod(void){
+    uint64_t h = 1;
+    for (int i = 0; i < num_tasks; ++i){
+        h = h / gcd_u64(h, tasks[i].period) * tasks[i].period;
+        if (h > (UINT64_C(1) << 48)) return 0;
+    }
+    return h;
+}
+
+// Idle instant of a probe run over [target - window, target + window] that
+// is nearest to target, or target itself when the probe never idles.
+static uint64_t predict_idle(uint64_t target, uint64_t window){
+    uint64_t start = target > window ? target - window : 0;
+    sched_ctx *ctx = new_ctx();
+    if (!ctx || sched_seek_idle(ctx, start) != SCHED_OK){
+        sched_destroy(ctx);
+        return target;
+    }
+    uint64_t best = target, best_dist = UINT64_MAX;
+    sched_stats st;
+    for (;;){
+        sched_step(ctx);
+        sched_get_stats(ctx, &st);
+        if (st.now > target + window) break;
+        if (!sched_is_idle(ctx)) continue;
+        uint64_t dist = st.now > target ? st.now - target : target - st.now;
+        if (dist < best_dist){
+            best = st.now;
+            best_dist = dist;
+        }
+        if (st.now >= target) break;   // later instants are only farther
+    }
+    sched_destroy(ctx);
+    return best;
+}
+
+// ---------- Segments ----------
+static void *worker(void *arg){
+    (void)arg;
+    for (int k; (k = atomic_fetch_add(&next_seg, 1)) < num_segs; ){
+        Segment *s = &segs[k];
+        s->ctx = new_ctx();
+        int rc = s->ctx ? sched_seek_idle(s->ctx, s->begin) : SCHED_ERR_NOMEM;
+        if (rc == SCHED_OK) rc = sched_run_until(s->ctx, s->end);
+        if (rc != SCHED_OK){
+            fprintf(stderr, "Segment %d failed: %s\n", k, sched_strerror(rc));
+            atomic_store(&failed, true);
+            return NULL;
+        }
+        sched_get_stats(s->ctx, &s->stats);
+    }
+    return NULL;
+}
+
+// Joins the segments into the statistics of one run over [0, end). Takes
+// ownership of the segments' contexts.
+static void stitch(sched_stats *total){
+    memset(total, 0, sizeof *total);
+    stats_add_diff(total, &segs[0].stats, total);
+    segs[0].exact = true;
+    sched_ctx *truth = segs[0].ctx;   // the real schedule, at segs[k].begin
+    sched_stats zero, before, st;
+    memset(&zero, 0, sizeof zero);
+
+    for (int k = 1; k < num_segs; ++k){
+        Segment *s = &segs[k];
+        if (sched_is_idle(truth)){
+            s->exact = true;
+            stats_add_diff(total, &s->stats, &zero);
+            sched_destroy(truth);
+            truth = s->ctx;
+            continue;
+        }
+        // Misprediction: continue the real schedule next to a replay of
+        // the speculative one until both are idle at the same instant.
+        sched_ctx *spec = new_ctx();
+        if (!spec || sched_seek_idle(spec, s->begin) != SCHED_OK){
+            fprintf(stderr, "Out of memory\n");
+            exit(1);
+        }
+        sched_get_stats(truth, &before);
+        bool met = false;
+        do {
+            sched_step(truth);
+            sched_step(spec);
+            met = sched_is_idle(truth) && sched_is_idle(spec);
+            sched_get_stats(truth, &st);
+        } while (!met && st.now < s->end);
+        s->redone = st.now - s->begin;
+        stats_add_diff(total, &st, &before);
+        if (met){
+            sched_stats replay;
+            sched_get_stats(spec, &replay);
+            stats_add_diff(total, &s->stats, &replay);   // the rest of the segment
+            sched_destroy(truth);
+            truth = s->ctx;
+        } else {
+            sched_destroy(s->ctx);   // truth itself reached s->end
+        }
+        s->ctx = NULL;
+        sched_destroy(spec);
+    }
+    sched_get_stats(truth, &st);
+    total->now = st.now;
+    sched_destroy(truth);
+}
+
+// ---------- Input ----------
+static bool load_tasks(const char *path, uint64_t *t_end){
+    sched_ctx *ctx = sched_create(policy, NULL);
+    int rc = ctx ? sched_load_input(ctx, path, t_end) : SCHED_ERR_NOMEM;
+    if (rc == SCHED_OK && sched_num_tasks(ctx) > MAX_TASKS) rc = SCHED_ERR_INVAL;
+    if (rc == SCHED_OK){
+        num_tasks = sched_num_tasks(ctx);
+        for (int i = 0; i < num_tasks; ++i){
+            tasks[i] = *sched_get_task(ctx, i);
+            snprintf(task_names[i], sizeof task_names[i], "%s", tasks[i].name);
+            tasks[i].name = task_names[i];
+        }
+        sched_get_power(ctx, power, &power_idle);
+    }
+    sched_destroy(ctx);
+    return rc == SCHED_OK;
+}
+
+static void print_stats(const sched_stats *st){
+    printf("  Released=%llu Completed=%llu Preemptions=%llu Misses=%llu\n",
+           (unsigned long long)st->released, (unsigned long long)st->completed,
+           (unsigned long long)st->preemptions, (unsigned long long)st->misses);
+    printf("  Busy=%llu Idle=%llu ticks, Energy: Busy=%.4f Idle=%.4f Total=%.4f\n",
+           (unsigned long long)st->busy_ticks, (unsigned long long)st->idle_ticks,
+           st->energy_busy, st->energy_idle, st->energy_busy + st->energy_idle);
+}
+
+static bool same_stats(const sched_stats *a, const sched_stats *b){
+    bool ok = a->now == b->now && a->released == b->released && a->completed == b->completed &&
+              a->preemptions == b->preemptions && a->misses == b->misses &&
+              a->busy_ticks == b->busy_ticks && a->idle_ticks == b->idle_ticks;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f) ok = ok && a->freq_ticks[f] == b->freq_ticks[f];
+    // Energies are summed in a different order
+    double ea = a->energy_busy + a->energy_idle, eb = b->energy_busy + b->energy_idle;
+    return ok && fabs(ea - eb) <= 1e-9 * fmax(fabs(ea), 1.0);
+}
+
+int main(int argc, char **argv){
+    const char *input = "test_input.txt";
+    int threads = 4, nseg = 0;
+    uint64_t end = 0, t_end = 0;
+    bool verify = false;
+    int k = 1;
+    if (k < argc && (strcmp(argv[k], "edf") == 0 || strcmp(argv[k], "rm") == 0)){
+        policy = (strcmp(argv[k], "edf") == 0) ? SCHED_EDF : SCHED_RM;
+        k++;
+    }
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--ee") == 0) ee = true;
+        else if (strcmp(argv[k], "--verify") == 0) verify = true;
+        else if (k + 1 >= argc) break;
+        else if (strcmp(argv[k], "--end") == 0) end = strtoull(argv[++k], NULL, 10);
+        else if (strcmp(argv[k], "--threads") == 0) threads = atoi(argv[++k]);
+        else if (strcmp(argv[k], "--segments") == 0) nseg = atoi(argv[++k]);
+        else break;
+    }
+    if (k < argc){
+        fprintf(stderr, "Usage: %s [edf|rm] [input_file] [--end T] [--threads N] [--segments S] "
+                        "[--ee] [--verify]\n", argv[0]);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (!load_tasks(input, &t_end)){
+        fprintf(stderr, "Cannot read task set from %s\n", input);
+        return 1;
+    }
+    if (end) t_end = end;
+    if (nseg < 1) nseg = threads * 4;
+    if (nseg > MAX_SEGMENTS) nseg = MAX_SEGMENTS;
+    if ((uint64_t)nseg > t_end) nseg = t_end ? (int)t_end : 1;
+
+    // Boundaries
+    double t0 = now_sec();
+    uint64_t seg_len = t_end / nseg, h = hyperperiod(), max_t = 1;
+    for (int i = 0; i < num_tasks; ++i){
+        uint64_t d = tasks[i].deadline > tasks[i].period ? tasks[i].deadline : tasks[i].period;
+        if (d + tasks[i].phase > max_t) max_t = d + tasks[i].phase;
+    }
+    uint64_t window = 4 * max_t;
+    if (window > seg_len / 2) window = seg_len / 2;
+    num_segs = 0;
+    uint64_t prev = 0;
+    for (int i = 1; i < nseg; ++i){
+        uint64_t target = seg_len * i;
+        if (h && h <= seg_len) target = (target + h / 2) / h * h;
+        uint64_t b = predict_idle(target, window);
+        if (b <= prev || b >= t_end) continue;   // collapsed into a neighbour
+        segs[num_segs++] = (Segment){ .begin = prev, .end = b };
+        prev = b;
+    }
+    segs[num_segs++] = (Segment){ .begin = prev, .end = t_end };
+    double t1 = now_sec();
+
+    atomic_init(&next_seg, 0);
+    atomic_init(&failed, false);
+    pthread_t tid[MAX_THREADS];
+    for (int i = 0; i < threads; ++i) pthread_create(&tid[i], NULL, worker, NULL);
+    for (int i = 0; i < threads; ++i) pthread_join(tid[i], NULL);
+    if (atomic_load(&failed)) return 1;
+    double t2 = now_sec();
+
+    sched_stats total;
+    stitch(&total);
+    double t3 = now_sec();
+
+    printf("=== Time-parallel %s%s: t < %llu in %d segments on %d threads ===\n",
+           policy == SCHED_EDF ? "EDF" : "RM", ee ? " (EE)" : "", (unsigned long long)t_end,
+           num_segs, threads);
+    if (h) printf("Hyperperiod %llu, probe window %llu\n", (unsigned long long)h,
+                  (unsigned long long)window);
+    int mispredicted = 0;
+    uint64_t redone = 0;
+    for (int i = 0; i < num_segs; ++i){
+        const Segment *s = &segs[i];
+        printf("  [%10llu, %10llu)  %s", (unsigned long long)s->begin,
+               (unsigned long long)s->end, s->exact ? "idle at start" : "MISPREDICTED");
+        if (!s->exact) printf(", %llu ticks re-simulated", (unsigned long long)s->redone);
+        printf("\n");
+        mispredicted += !s->exact;
+        redone += s->redone;
+    }
+    printf("Stitched result:\n");
+    print_stats(&total);
+    printf("Mispredicted boundaries: %d, ticks re-simulated: %llu (%.3f%%)\n", mispredicted,
+           (unsigned long long)redone, t_end ? 100.0 * redone / t_end : 0.0);
+    printf("Time: boundaries %.3f s, segments %.3f s, stitch %.3f s\n", t1 - t0, t2 - t1, t3 - t2);
+
+    if (verify){
+        sched_ctx *ctx = new_ctx();
+        if (!ctx){
+            fprintf(stderr, "Out of memory\n");
+            return 1;
+        }
+        double v0 = now_sec();
+        sched_run_until(ctx, t_end);
+        double v1 = now_sec();
+        sched_stats seq;
+        sched_get_stats(ctx, &seq);
+        sched_destroy(ctx);
+        printf("Sequential run (%.3f s, speedup %.2fx):\n", v1 - v0, (v1 - v0) / (t3 - t0));
+        print_stats(&seq);
+        bool ok = same_stats(&total, &seq);
+        printf("Verification: %s\n", ok ? "stitched result matches" : "MISMATCH");
+        if (!ok) return 2;
+    }
+    return 0;
+}
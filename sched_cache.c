@@ -0,0 +1,202 @@
+// sched_cache.c
+// Memory-mapped result cache; see sched_cache.h for the API.
+
+#define _POSIX_C_SOURCE 200809L
+#include "sched_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CACHE_MAGIC   0x43334150u  // "PA3C"
+#define CACHE_FORMAT  1
+#define MAX_PROBE     64           // slots tried per lookup before giving up
+
+enum { SLOT_EMPTY, SLOT_WRITING, SLOT_READY };
+
+// Slot states are shared between processes through the mapping.
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "slot state must be a lock-free atomic");
+
+// File layout: Header, then `slots` Slots. Everything is zero on creation,
+// which is what an empty slot looks like.
+typedef struct {
+    uint32_t magic;
+    uint32_t format;
+    uint32_t engine_version;
+    uint32_t stats_size;
+    uint32_t slots;
+    uint32_t reserved[11];
+} Header;
+
+typedef struct {
+    _Atomic uint32_t state;
+    uint32_t reserved;
+    uint64_t key[2];
+    sched_stats stats;
+} Slot;
+
+struct sched_cache {
+    int fd;
+    void *base;
+    size_t size;
+    Slot *slots;
+    uint32_t num_slots;
+};
+
+static size_t file_size(uint32_t slots){
+    return sizeof(Header) + (size_t)slots * sizeof(Slot);
+}
+
+static bool header_valid(const Header *h, off_t size){
+    return h->magic == CACHE_MAGIC && h->format == CACHE_FORMAT &&
+           h->engine_version == SCHED_ENGINE_VERSION && h->stats_size == sizeof(sched_stats) &&
+           h->slots > 0 && (off_t)file_size(h->slots) == size;
+}
+
+static Header new_header(uint32_t slots){
+    Header h;
+    memset(&h, 0, sizeof h);
+    h.magic = CACHE_MAGIC;
+    h.format = CACHE_FORMAT;
+    h.engine_version = SCHED_ENGINE_VERSION;
+    h.stats_size = sizeof(sched_stats);
+    h.slots = slots;
+    return h;
+}
+
+// Sizes the (empty or fresh) file fd and writes its header.
+static bool init_file(int fd, uint32_t slots){
+    Header h = new_header(slots);
+    return ftruncate(fd, (off_t)file_size(slots)) == 0 &&
+           pwrite(fd, &h, sizeof h, 0) == (ssize_t)sizeof h;
+}
+
+static bool lock_file(int fd, short type){
+    struct flock fl;
+    memset(&fl, 0, sizeof fl);
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    return fcntl(fd, F_SETLKW, &fl) == 0;
+}
+
+// Replaces a stale file by a fresh one through rename, so processes that
+// still map the old file are not cut off under their feet.
+static bool replace_file(const char *path, uint32_t slots){
+    char tmp[4096];
+    if (snprintf(tmp, sizeof tmp, "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof tmp)
+        return false;
+    int fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = init_file(fd, slots);
+    close(fd);
+    if (ok) ok = rename(tmp, path) == 0;
+    if (!ok) unlink(tmp);
+    return ok;
+}
+
+sched_cache *sched_cache_open(const char *path, uint32_t slots){
+    if (!path) return NULL;
+    if (slots == 0) slots = SCHED_CACHE_DEFAULT_SLOTS;
+
+    // Opening, validating and (re)initializing happen under an exclusive
+    // lock; lookups and inserts later never take it.
+    for (int attempt = 0; attempt < 8; ++attempt){
+        int fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) return NULL;
+        struct stat fs, ps;
+        if (!lock_file(fd, F_WRLCK) || fstat(fd, &fs) != 0){
+            close(fd);
+            return NULL;
+        }
+        if (stat(path, &ps) != 0 || ps.st_ino != fs.st_ino || ps.st_dev != fs.st_dev){
+            close(fd);   // replaced while we waited for the lock
+            continue;
+        }
+
+        Header h;
+        bool valid = fs.st_size >= (off_t)sizeof h &&
+                     pread(fd, &h, sizeof h, 0) == (ssize_t)sizeof h &&
+                     header_valid(&h, fs.st_size);
+        if (!valid){
+            bool ok = (fs.st_size == 0) ? init_file(fd, slots) : replace_file(path, slots);
+            if (!ok){
+                close(fd);
+                return NULL;
+            }
+            if (fs.st_size != 0){
+                close(fd);   // reopen the replacement
+                continue;
+            }
+            h = new_header(slots);
+        }
+
+        sched_cache *c = malloc(sizeof *c);
+        size_t size = file_size(h.slots);
+        void *base = c ? mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        lock_file(fd, F_UNLCK);
+        if (base == MAP_FAILED){
+            free(c);
+            close(fd);
+            return NULL;
+        }
+        c->fd = fd;
+        c->base = base;
+        c->size = size;
+        c->slots = (Slot *)((char *)base + sizeof(Header));
+        c->num_slots = h.slots;
+        return c;
+    }
+    return NULL;
+}
+
+void sched_cache_close(sched_cache *cache){
+    if (!cache) return;
+    munmap(cache->base, cache->size);
+    close(cache->fd);
+    free(cache);
+}
+
+int sched_cache_get(const sched_cache *cache, const uint64_t key[2], sched_stats *out){
+    if (!cache || !key || !out) return 0;
+    for (uint32_t i = 0; i < MAX_PROBE && i < cache->num_slots; ++i){
+        Slot *s = &cache->slots[(key[0] + i) % cache->num_slots];
+        uint32_t state = atomic_load_explicit(&s->state, memory_order_acquire);
+        if (state == SLOT_EMPTY) return 0;
+        if (state == SLOT_READY && s->key[0] == key[0] && s->key[1] == key[1]){
+            memcpy(out, &s->stats, sizeof *out);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int sched_cache_put(sched_cache *cache, const uint64_t key[2], const sched_stats *stats){
+    if (!cache || !key || !stats) return SCHED_ERR_INVAL;
+    for (uint32_t i = 0; i < MAX_PROBE && i < cache->num_slots; ++i){
+        Slot *s = &cache->slots[(key[0] + i) % cache->num_slots];
+        uint32_t state = atomic_load_explicit(&s->state, memory_order_acquire);
+        if (state == SLOT_EMPTY){
+            if (!atomic_compare_exchange_strong_explicit(&s->state, &state, SLOT_WRITING,
+                                                         memory_order_acquire,
+                                                         memory_order_acquire)){
+                if (state == SLOT_WRITING) continue;
+                // state is now SLOT_READY: fall through and compare keys
+            } else {
+                s->key[0] = key[0];
+                s->key[1] = key[1];
+                memcpy(&s->stats, stats, sizeof *stats);
+                atomic_store_explicit(&s->state, SLOT_READY, memory_order_release);
+                return SCHED_OK;
+            }
+        }
+        if (state == SLOT_READY && s->key[0] == key[0] && s->key[1] == key[1])
+            return SCHED_OK;   // another writer got there first
+    }
+    return SCHED_ERR_NOMEM;
+}
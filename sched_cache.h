@@ -0,0 +1,48 @@
+// sched_cache.h
+// On-disk, memory-mapped cache of libsched results keyed by
+// sched_config_hash(), so identical task sets are simulated only once
+// across experiments and processes.
+// Build: gcc -O2 -std=c11 -c sched_cache.c   (link with sched_lib.c)
+//
+//   sched_cache *c = sched_cache_open("results.cache", 0);
+//   uint64_t key[2];
+//   if (sched_config_hash(ctx, end, key) == SCHED_OK && sched_cache_get(c, key, &st) == 1)
+//       ... hit, no simulation ...
+//   else { sched_run_until(ctx, end); sched_get_stats(ctx, &st); sched_cache_put(c, key, &st); }
+//
+// The file is a fixed-size open-addressing table. A slot is written once:
+// a writer claims an empty slot with a compare-and-swap, fills it and then
+// publishes it, so lookups take no lock and may run concurrently with
+// writers in any thread or process mapping the same file. A file written
+// by a different SCHED_ENGINE_VERSION is wiped when opened. The cache is
+// best effort: a full table simply stops taking new results.
+
+#ifndef SCHED_CACHE_H
+#define SCHED_CACHE_H
+
+#include <stdint.h>
+#include "sched_lib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_CACHE_DEFAULT_SLOTS 65536
+
+typedef struct sched_cache sched_cache;
+
+// Opens or creates path. slots (0: default) only applies to a new or wiped
+// file. Returns NULL on failure.
+sched_cache *sched_cache_open(const char *path, uint32_t slots);
+void sched_cache_close(sched_cache *cache);
+
+// 1 on a hit (*out filled), 0 on a miss.
+int sched_cache_get(const sched_cache *cache, const uint64_t key[2], sched_stats *out);
+// SCHED_OK, or SCHED_ERR_NOMEM when no free slot is within reach.
+int sched_cache_put(sched_cache *cache, const uint64_t key[2], const sched_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_CACHE_H
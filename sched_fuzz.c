@@ -0,0 +1,509 @@
+// sched_fuzz.c
+// Differential fuzzing of libsched against the reference tick loop of
+// EDF.cpp / RM_Scheduler.c.
+// Build: gcc -O2 -std=c11 sched_fuzz.c sched_lib.c -o sched_fuzz -lm
+// Run:   ./sched_fuzz [cases] [seed]
+// libFuzzer: clang -g -O1 -fsanitize=fuzzer,address -DSCHED_FUZZ_LIBFUZZER sched_fuzz.c sched_lib.c -lm
+//
+// Each case is a random task set (phases, constrained and arbitrary
+// deadlines, equal periods to exercise the RM tie-break), a policy, a fixed
+// frequency level and a horizon. The oracle below is the simulators' loop
+// copied statement for statement, only moved into a struct so it can run
+// many times. Every engine runs the same case and must produce the same
+// event stream and the same summary. On a mismatch the case is shrunk
+// (drop tasks, shorten the horizon) and printed together with the first
+// diverging event.
+//
+// Engines are listed in ENGINES[]; a new fast path is validated by adding
+// one entry that runs a case and records its events.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_lib.h"
+
+#define MAX_TASKS 12
+#define MAX_END   4000
+
+typedef struct {
+    sched_policy policy;
+    int level;                         // fixed frequency level
+    uint64_t end;                      // simulators' SIMULATION_END (t <= end)
+    int n;
+    sched_task tasks[MAX_TASKS];
+    char names[MAX_TASKS][12];
+} Case;
+
+typedef struct {
+    sched_event *ev;
+    size_t count, cap;
+    bool overflow;                     // reference ready queue overflowed
+    uint64_t completed, preemptions, misses, busy, idle;
+} Trace;
+
+static bool trace_push(Trace *tr, sched_event_type type, uint64_t time, int task_id,
+                       uint64_t job_seq, uint64_t release, uint64_t deadline, int freq){
+    if (tr->count == tr->cap){
+        size_t ncap = tr->cap ? tr->cap * 2 : 256;
+        sched_event *p = realloc(tr->ev, ncap * sizeof *p);
+        if (!p) return false;
+        tr->ev = p;
+        tr->cap = ncap;
+    }
+    sched_event *e = &tr->ev[tr->count++];
+    e->type = type;
+    e->time = time;
+    e->task_id = task_id;
+    e->job_seq = job_seq;
+    e->release_time = release;
+    e->abs_deadline = deadline;
+    e->freq = freq;
+    return true;
+}
+
+static void trace_reset(Trace *tr){
+    sched_event *ev = tr->ev;
+    size_t cap = tr->cap;
+    memset(tr, 0, sizeof *tr);
+    tr->ev = ev;
+    tr->cap = cap;
+}
+
+// ---------- Reference: EDF.cpp / RM_Scheduler.c ----------
+#define READY_QUEUE_SIZE 128
+
+typedef struct {
+    int task_id;
+    uint64_t release_time;
+    uint64_t abs_deadline;
+    uint32_t remaining;   // ticks left
+    uint64_t job_seq;     // 0,1,2,... per task
+} Job;
+
+typedef struct {
+    const Case *c;
+    Job readyJobs[READY_QUEUE_SIZE];
+    int readyJobCount;
+    bool cpu_busy;
+    Job currentJob;
+    uint64_t next_seq[MAX_TASKS];
+    Trace *tr;
+} Ref;
+
+static void rq_push(Ref *r, Job j){
+    if (r->readyJobCount < READY_QUEUE_SIZE) {
+        r->readyJobs[r->readyJobCount++] = j;
+    } else {
+        r->tr->overflow = true;   // "Ready queue full; dropping job!"
+    }
+}
+
+static void rq_remove_idx(Ref *r, int idx){
+    if (idx < 0 || idx >= r->readyJobCount) return;
+    r->readyJobs[idx] = r->readyJobs[--r->readyJobCount];
+}
+
+static int rq_earliest_deadline_idx(const Ref *r){
+    if (r->readyJobCount == 0) return -1;
+    int best = 0;
+    for (int i = 1; i < r->readyJobCount; ++i) {
+        if (r->readyJobs[i].abs_deadline < r->readyJobs[best].abs_deadline) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static int rq_highest_rm_idx(const Ref *r){
+    if (r->readyJobCount == 0) return -1;
+    const sched_task *tasks = r->c->tasks;
+    int best = 0;
+    for (int i = 1; i < r->readyJobCount; ++i) {
+        int a = r->readyJobs[i].task_id, b = r->readyJobs[best].task_id;
+        if (tasks[a].period < tasks[b].period) {
+            best = i;
+        } else if (tasks[a].period == tasks[b].period) {
+            if (r->readyJobs[i].abs_deadline < r->readyJobs[best].abs_deadline) {
+                best = i;
+            } else if (r->readyJobs[i].abs_deadline == r->readyJobs[best].abs_deadline && a < b) {
+                best = i;
+            }
+        }
+    }
+    return best;
+}
+
+static void ref_emit(Ref *r, sched_event_type type, uint64_t t, const Job *j){
+    trace_push(r->tr, type, t, j->task_id, j->job_seq, j->release_time, j->abs_deadline,
+               r->c->level);
+}
+
+// COMPLETE is recorded at t + 1 (end of the tick), as libsched reports it.
+static void run_reference(const Case *c, Trace *tr){
+    static Ref ref;
+    Ref *r = &ref;
+    memset(r, 0, sizeof *r);
+    r->c = c;
+    r->tr = tr;
+    const sched_task *tasks = c->tasks;
+    int N = c->n;
+
+    for (uint64_t t = 0; t <= c->end; ++t) {
+        // 1) Releases at time t
+        for (int i = 0; i < N; ++i) {
+            const sched_task *ti = &tasks[i];
+            if (t >= ti->phase && ((t - ti->phase) % ti->period == 0)) {
+                Job j;
+                j.task_id = i;
+                j.release_time = t;
+                j.abs_deadline = t + (ti->deadline ? ti->deadline : ti->period);
+                j.remaining = ti->wcet[c->level];
+                j.job_seq = r->next_seq[i]++;
+                rq_push(r, j);
+                ref_emit(r, SCHED_EV_RELEASE, t, &j);
+            }
+        }
+
+        // 2) Check for deadline misses
+        if (r->cpu_busy && t > r->currentJob.abs_deadline && r->currentJob.remaining > 0) {
+            ref_emit(r, SCHED_EV_MISS, t, &r->currentJob);
+            tr->misses++;
+            r->cpu_busy = false; // Mark CPU as idle
+        }
+        for (int i = 0; i < r->readyJobCount; ++i) {
+            if (t > r->readyJobs[i].abs_deadline && r->readyJobs[i].remaining > 0) {
+                ref_emit(r, SCHED_EV_MISS, t, &r->readyJobs[i]);
+                tr->misses++;
+                rq_remove_idx(r, i);
+                i--; // Adjust index after removal
+            }
+        }
+
+        // 3) Select job to run
+        int idx = (c->policy == SCHED_EDF) ? rq_earliest_deadline_idx(r) : rq_highest_rm_idx(r);
+        if (!r->cpu_busy) {
+            if (idx != -1) {
+                r->currentJob = r->readyJobs[idx];
+                rq_remove_idx(r, idx);
+                r->cpu_busy = true;
+                ref_emit(r, SCHED_EV_START, t, &r->currentJob);
+            }
+        } else if (idx != -1) {
+            bool preempt = (c->policy == SCHED_EDF)
+                ? r->readyJobs[idx].abs_deadline < r->currentJob.abs_deadline
+                : tasks[r->readyJobs[idx].task_id].period < tasks[r->currentJob.task_id].period;
+            if (preempt) {
+                rq_push(r, r->currentJob); // Preempt current job
+                r->currentJob = r->readyJobs[idx];
+                rq_remove_idx(r, idx);
+                tr->preemptions++;
+                ref_emit(r, SCHED_EV_PREEMPT, t, &r->currentJob);
+            }
+        }
+
+        // 4) Execute the running job
+        if (r->cpu_busy) {
+            tr->busy++;
+            r->currentJob.remaining--;
+            if (r->currentJob.remaining == 0) {
+                ref_emit(r, SCHED_EV_COMPLETE, t + 1, &r->currentJob);
+                tr->completed++;
+                r->cpu_busy = false; // Mark CPU as idle
+            }
+        } else {
+            tr->idle++;
+        }
+    }
+}
+
+// ---------- Engines under test ----------
+static void record_event(void *user, const sched_event *ev){
+    Trace *tr = user;
+    if (ev->type >= SCHED_EV_FREQ) return;   // the reference has no DVFS or DPM
+    trace_push(tr, ev->type, ev->time, ev->task_id, ev->job_seq, ev->release_time,
+               ev->abs_deadline, ev->freq);
+}
+
+static sched_ctx *case_ctx(const Case *c, Trace *tr){
+    sched_ctx *ctx = sched_create(c->policy, NULL);
+    if (!ctx) return NULL;
+    for (int i = 0; i < c->n; ++i) sched_add_task(ctx, &c->tasks[i]);
+    sched_set_freq(ctx, SCHED_FREQ_FIXED, c->level);
+    sched_set_event_callback(ctx, record_event, tr);
+    return ctx;
+}
+
+// Adds a context's statistics to the trace's summary.
+static void add_stats(Trace *tr, const sched_ctx *ctx){
+    sched_stats st;
+    sched_get_stats(ctx, &st);
+    tr->completed += st.completed;
+    tr->preemptions += st.preemptions;
+    tr->misses += st.misses;
+    tr->busy += st.busy_ticks;
+    tr->idle += st.idle_ticks;
+}
+
+// chunk == 0: one sched_run_until; otherwise pseudo-random slices of at most
+// chunk ticks, so state carried across calls is exercised too.
+static void run_libsched(const Case *c, Trace *tr, uint64_t chunk){
+    sched_ctx *ctx = case_ctx(c, tr);
+    if (!ctx){ tr->overflow = true; return; }
+
+    uint64_t end = c->end + 1;
+    if (chunk == 0){
+        sched_run_until(ctx, end);
+    } else {
+        uint64_t t = 0, x = chunk * 2654435761u + c->end;
+        while (t < end){
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint64_t len = 1 + (x >> 33) % chunk;
+            t = (end - t > len) ? t + len : end;
+            sched_run_until(ctx, t);
+        }
+    }
+    add_stats(tr, ctx);
+    sched_destroy(ctx);
+}
+
+// Restarts the run at pseudo-randomly chosen idle instants: the context is
+// dropped and a fresh one is put there with sched_seek_idle, as
+// parallel_sim does at its segment boundaries.
+static void run_libsched_seek(const Case *c, Trace *tr){
+    sched_ctx *ctx = case_ctx(c, tr);
+    if (!ctx){ tr->overflow = true; return; }
+    uint64_t end = c->end + 1, x = c->end * 2654435761u + (uint64_t)c->n;
+    for (uint64_t t = 0; t < end; ++t){
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        if (t > 0 && sched_is_idle(ctx) && (x >> 62) == 0){
+            add_stats(tr, ctx);
+            sched_destroy(ctx);
+            ctx = case_ctx(c, tr);
+            if (!ctx || sched_seek_idle(ctx, t) != SCHED_OK){
+                sched_destroy(ctx);
+                tr->overflow = true;
+                return;
+            }
+        }
+        sched_step(ctx);
+    }
+    add_stats(tr, ctx);
+    sched_destroy(ctx);
+}
+
+static void run_libsched_whole(const Case *c, Trace *tr){ run_libsched(c, tr, 0); }
+static void run_libsched_chunked(const Case *c, Trace *tr){ run_libsched(c, tr, 37); }
+static void run_libsched_stepped(const Case *c, Trace *tr){ run_libsched(c, tr, 1); }
+
+typedef struct {
+    const char *name;
+    void (*run)(const Case *c, Trace *tr);
+} Engine;
+
+static const Engine ENGINES[] = {
+    { "libsched run_until",         run_libsched_whole },
+    { "libsched run_until chunked", run_libsched_chunked },
+    { "libsched step",              run_libsched_stepped },
+    { "libsched seek_idle",         run_libsched_seek },
+};
+#define NUM_ENGINES (int)(sizeof ENGINES / sizeof ENGINES[0])
+
+// ---------- Case generation ----------
+// Cases are decoded from a byte stream so libFuzzer can drive them; the
+// standalone driver feeds it from a PRNG instead.
+typedef struct {
+    const uint8_t *data;
+    size_t size, pos;
+    uint64_t rng;                      // used when data == NULL
+} Source;
+
+static uint32_t src_u32(Source *s){
+    if (!s->data){
+        // xorshift64*
+        s->rng ^= s->rng >> 12;
+        s->rng ^= s->rng << 25;
+        s->rng ^= s->rng >> 27;
+        return (uint32_t)((s->rng * 0x2545F4914F6CDD1DULL) >> 32);
+    }
+    uint32_t v = 0;
+    for (int k = 0; k < 4; ++k)
+        v = (v << 8) | (s->pos < s->size ? s->data[s->pos++] : 0);
+    return v;
+}
+
+static uint32_t src_range(Source *s, uint32_t lo, uint32_t hi){
+    return lo + src_u32(s) % (hi - lo + 1);
+}
+
+static void make_case(Source *s, Case *c){
+    memset(c, 0, sizeof *c);
+    c->policy = (src_u32(s) & 1) ? SCHED_RM : SCHED_EDF;
+    c->level = (int)src_range(s, 0, SCHED_NUM_FREQS - 1);
+    c->end = src_range(s, 0, MAX_END);
+    c->n = (int)src_range(s, 1, MAX_TASKS);
+    for (int i = 0; i < c->n; ++i){
+        sched_task *t = &c->tasks[i];
+        snprintf(c->names[i], sizeof c->names[i], "T%d", i + 1);
+        t->name = c->names[i];
+        // Reuse an earlier period now and then: RM ties on equal periods.
+        if (i > 0 && src_range(s, 0, 3) == 0) t->period = c->tasks[src_range(s, 0, i - 1)].period;
+        else t->period = src_range(s, 2, 120);
+        uint32_t c0 = src_range(s, 1, t->period / 3 + 1);
+        for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+            c0 += src_range(s, 0, c0 / 2 + 1);   // slower levels take longer
+            t->wcet[f] = c0;
+        }
+        switch (src_range(s, 0, 3)){
+        case 0:  t->deadline = 0; break;                                      // D = T
+        case 1:  t->deadline = src_range(s, 1, t->period); break;             // D <= T
+        case 2:  t->deadline = src_range(s, t->period, 2 * t->period); break; // D >= T
+        default: t->deadline = t->period; break;
+        }
+        t->phase = (src_range(s, 0, 2) == 0) ? src_range(s, 0, 2 * t->period) : 0;
+    }
+}
+
+// ---------- Comparison ----------
+static const char *EVENT_NAMES[] = { "RELEASE", "START", "PREEMPT", "COMPLETE", "MISS" };
+
+static void print_event(const char *who, const Case *c, const sched_event *e){
+    if (!e){
+        printf("  %-28s <end of stream>\n", who);
+        return;
+    }
+    printf("  %-28s [t=%llu] %s %s#%llu (rel=%llu, dl=%llu)\n", who,
+           (unsigned long long)e->time, EVENT_NAMES[e->type], c->tasks[e->task_id].name,
+           (unsigned long long)e->job_seq, (unsigned long long)e->release_time,
+           (unsigned long long)e->abs_deadline);
+}
+
+static bool same_event(const sched_event *a, const sched_event *b){
+    return a->type == b->type && a->time == b->time && a->task_id == b->task_id &&
+           a->job_seq == b->job_seq && a->release_time == b->release_time &&
+           a->abs_deadline == b->abs_deadline && a->freq == b->freq;
+}
+
+// Index of the first differing event, (size_t)-1 if the streams agree.
+static size_t first_divergence(const Trace *a, const Trace *b){
+    size_t n = a->count < b->count ? a->count : b->count;
+    for (size_t i = 0; i < n; ++i)
+        if (!same_event(&a->ev[i], &b->ev[i])) return i;
+    return (a->count == b->count) ? (size_t)-1 : n;
+}
+
+static bool same_summary(const Trace *a, const Trace *b){
+    return a->completed == b->completed && a->preemptions == b->preemptions &&
+           a->misses == b->misses && a->busy == b->busy && a->idle == b->idle;
+}
+
+static Trace ref_trace, eng_trace;
+
+// Returns the index of the first engine that disagrees with the reference,
+// -1 if all agree, -2 if the case is outside the reference's domain.
+static int check_case(const Case *c){
+    trace_reset(&ref_trace);
+    run_reference(c, &ref_trace);
+    if (ref_trace.overflow) return -2;
+    for (int e = 0; e < NUM_ENGINES; ++e){
+        trace_reset(&eng_trace);
+        ENGINES[e].run(c, &eng_trace);
+        if (first_divergence(&ref_trace, &eng_trace) != (size_t)-1 ||
+            !same_summary(&ref_trace, &eng_trace))
+            return e;
+    }
+    return -1;
+}
+
+// Greedy shrinking: drop tasks, then shorten the horizon, while the case
+// keeps failing.
+static void shrink(Case *c){
+    bool progress = true;
+    while (progress){
+        progress = false;
+        for (int i = 0; i < c->n && c->n > 1; ++i){
+            Case t = *c;
+            memmove(&t.tasks[i], &t.tasks[i + 1], (size_t)(t.n - i - 1) * sizeof t.tasks[0]);
+            memmove(t.names[i], t.names[i + 1], (size_t)(t.n - i - 1) * sizeof t.names[0]);
+            t.n--;
+            for (int k = 0; k < t.n; ++k) t.tasks[k].name = t.names[k];
+            if (check_case(&t) >= 0){ *c = t; progress = true; --i; }
+        }
+        for (uint64_t step = c->end / 2; step > 0; step /= 2){
+            Case t = *c;
+            t.end -= step;
+            if (check_case(&t) >= 0){ *c = t; progress = true; break; }
+        }
+    }
+    for (int k = 0; k < c->n; ++k) c->tasks[k].name = c->names[k];
+}
+
+static void report_failure(Case *c){
+    shrink(c);
+    int e = check_case(c);
+    printf("MISMATCH: %s vs. reference, %s at level %d, t <= %llu\n", ENGINES[e].name,
+           c->policy == SCHED_EDF ? "EDF" : "RM", c->level, (unsigned long long)c->end);
+    printf("  name period wcet[0..3] deadline phase\n");
+    for (int i = 0; i < c->n; ++i){
+        const sched_task *t = &c->tasks[i];
+        printf("  %s %u %u %u %u %u %u %u\n", t->name, t->period, t->wcet[0], t->wcet[1],
+               t->wcet[2], t->wcet[3], t->deadline, t->phase);
+    }
+    size_t at = first_divergence(&ref_trace, &eng_trace);
+    if (at != (size_t)-1){
+        printf("  first divergence at event %zu:\n", at);
+        print_event("reference", c, at < ref_trace.count ? &ref_trace.ev[at] : NULL);
+        print_event(ENGINES[e].name, c, at < eng_trace.count ? &eng_trace.ev[at] : NULL);
+    }
+    printf("  %-28s Completed=%llu, Preemptions=%llu, Misses=%llu, Busy=%llu, Idle=%llu\n",
+           "reference", (unsigned long long)ref_trace.completed,
+           (unsigned long long)ref_trace.preemptions, (unsigned long long)ref_trace.misses,
+           (unsigned long long)ref_trace.busy, (unsigned long long)ref_trace.idle);
+    printf("  %-28s Completed=%llu, Preemptions=%llu, Misses=%llu, Busy=%llu, Idle=%llu\n",
+           ENGINES[e].name, (unsigned long long)eng_trace.completed,
+           (unsigned long long)eng_trace.preemptions, (unsigned long long)eng_trace.misses,
+           (unsigned long long)eng_trace.busy, (unsigned long long)eng_trace.idle);
+}
+
+#ifdef SCHED_FUZZ_LIBFUZZER
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size){
+    Source s = { data, size, 0, 0 };
+    Case c;
+    make_case(&s, &c);
+    if (check_case(&c) >= 0){
+        report_failure(&c);
+        abort();
+    }
+    return 0;
+}
+#else
+int main(int argc, char **argv){
+    long cases = (argc >= 2) ? atol(argv[1]) : 20000;
+    Source s = { NULL, 0, 0, (argc >= 3) ? strtoull(argv[2], NULL, 10) : 88172645463325252ULL };
+    if (cases <= 0 || s.rng == 0){
+        fprintf(stderr, "Usage: %s [cases] [seed]   (both positive)\n", argv[0]);
+        return 1;
+    }
+
+    long skipped = 0;
+    uint64_t events = 0;
+    for (long k = 0; k < cases; ++k){
+        Case c;
+        make_case(&s, &c);
+        int rc = check_case(&c);
+        if (rc == -2){ skipped++; continue; }
+        events += ref_trace.count;
+        if (rc >= 0){
+            printf("case %ld:\n", k);
+            report_failure(&c);
+            return 2;
+        }
+    }
+    printf("%ld cases, %llu reference events, %d engines: no divergence (%ld skipped)\n",
+           cases - skipped, (unsigned long long)events, NUM_ENGINES, skipped);
+    free(ref_trace.ev);
+    free(eng_trace.ev);
+    return 0;
+}
+#endif
@@ -0,0 +1,815 @@
+// sched_lib.c
+// libsched implementation; see sched_lib.h for the API and build lines.
+
+#include "sched_lib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+
+// ---------- Profiling (-DSCHED_PROFILE) ----------
+// Times every phase of sched_step and counts ready-queue work in
+// per-thread counters; all threads' counters are printed to stderr at exit
+// or by sched_profile_dump(). Time spent in event callbacks is booked to the
+// "trace" phase only. Without SCHED_PROFILE the macros expand to nothing.
+#ifdef SCHED_PROFILE
+#include <stdatomic.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROF_UNIT "cycles (rdtsc)"
+static inline uint64_t prof_now(void){ return __rdtsc(); }
+#else
+#include <time.h>
+#define PROF_UNIT "ns (CLOCK_MONOTONIC)"
+static inline uint64_t prof_now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+enum { PH_DVFS, PH_DPM, PH_RELEASE, PH_MISS, PH_SELECT, PH_EXECUTE, PH_TRACE, PH_COUNT };
+static const char *PHASE_NAMES[PH_COUNT] = {
+    "dvfs", "dpm", "release", "miss check", "select/preempt", "execute/energy", "trace"
+};
+
+typedef struct ProfCounters {
+    uint64_t time[PH_COUNT];
+    uint64_t calls[PH_COUNT];
+    uint64_t steps;
+    uint64_t selections;      // ready-queue scans
+    uint64_t queue_len_sum;   // ready-queue length per scan
+    uint64_t queue_len_max;
+    uint64_t comparisons;     // job comparisons during scans
+    struct ProfCounters *next;
+} ProfCounters;
+
+// Counters are heap blocks that outlive their thread, linked lock-free so
+// the dump at exit still sees threads that have finished.
+static _Atomic(ProfCounters *) prof_all;
+static _Thread_local ProfCounters *prof_local;
+static atomic_flag prof_atexit = ATOMIC_FLAG_INIT;
+
+void sched_profile_dump(FILE *out);
+static void prof_dump_at_exit(void){ sched_profile_dump(stderr); }
+
+static ProfCounters *prof_tls(void){
+    if (prof_local) return prof_local;
+    ProfCounters *pc = calloc(1, sizeof *pc);
+    if (!pc){
+        static _Thread_local ProfCounters fallback;
+        return prof_local = &fallback;   // counted, but not in the dump
+    }
+    pc->next = atomic_load(&prof_all);
+    while (!atomic_compare_exchange_weak(&prof_all, &pc->next, pc)) {}
+    if (!atomic_flag_test_and_set(&prof_atexit)) atexit(prof_dump_at_exit);
+    return prof_local = pc;
+}
+
+static void prof_print(FILE *out, const char *label, const ProfCounters *pc){
+    uint64_t total = 0;
+    for (int p = 0; p < PH_COUNT; ++p) total += pc->time[p];
+    fprintf(out, "%s: %llu steps, %llu %s\n", label, (unsigned long long)pc->steps,
+            (unsigned long long)total, PROF_UNIT);
+    for (int p = 0; p < PH_COUNT; ++p){
+        fprintf(out, "  %-16s calls=%-12llu total=%-14llu per call=%9.1f  share=%5.1f%%\n",
+                PHASE_NAMES[p], (unsigned long long)pc->calls[p], (unsigned long long)pc->time[p],
+                pc->calls[p] ? (double)pc->time[p] / pc->calls[p] : 0.0,
+                total ? 100.0 * pc->time[p] / total : 0.0);
+    }
+    if (pc->selections){
+        fprintf(out, "  ready queue: %llu scans, mean length %.2f, max %llu, "
+                     "%.2f comparisons per scan\n",
+                (unsigned long long)pc->selections, (double)pc->queue_len_sum / pc->selections,
+                (unsigned long long)pc->queue_len_max, (double)pc->comparisons / pc->selections);
+    }
+}
+
+void sched_profile_dump(FILE *out){
+    ProfCounters sum;
+    memset(&sum, 0, sizeof sum);
+    int threads = 0;
+    for (ProfCounters *pc = atomic_load(&prof_all); pc; pc = pc->next){
+        char label[48];
+        snprintf(label, sizeof label, "libsched profile, thread %d", ++threads);
+        if (pc->next || threads > 1) prof_print(out, label, pc);
+        for (int p = 0; p < PH_COUNT; ++p){
+            sum.time[p] += pc->time[p];
+            sum.calls[p] += pc->calls[p];
+        }
+        sum.steps += pc->steps;
+        sum.selections += pc->selections;
+        sum.queue_len_sum += pc->queue_len_sum;
+        sum.comparisons += pc->comparisons;
+        if (pc->queue_len_max > sum.queue_len_max) sum.queue_len_max = pc->queue_len_max;
+    }
+    if (threads) prof_print(out, "libsched profile, all threads", &sum);
+}
+
+// PROF_BEGIN/PROF_END bracket a phase; callback time inside it is excluded.
+#define PROF_BEGIN(v) uint64_t v##_t0 = prof_now(), v##_tr = prof_tls()->time[PH_TRACE]
+#define PROF_END(v, ph) do { \
+        ProfCounters *pc_ = prof_tls(); \
+        pc_->time[ph] += prof_now() - v##_t0 - (pc_->time[PH_TRACE] - v##_tr); \
+        pc_->calls[ph]++; \
+    } while (0)
+#define PROF_SCAN(len) do { \
+        ProfCounters *pc_ = prof_tls(); \
+        uint64_t n_ = (uint64_t)(len); \
+        pc_->selections++; \
+        pc_->queue_len_sum += n_; \
+        if (n_ > pc_->queue_len_max) pc_->queue_len_max = n_; \
+        pc_->comparisons += n_ ? n_ - 1 : 0; \
+    } while (0)
+#define PROF_STEP() (prof_tls()->steps++)
+#else
+void sched_profile_dump(FILE *out){ (void)out; }
+#define PROF_BEGIN(v) ((void)0)
+#define PROF_END(v, ph) ((void)0)
+#define PROF_SCAN(len) ((void)0)
+#define PROF_STEP() ((void)0)
+#endif
+
+// A job's work is measured in units where a whole job is `work` units
+// (lcm of the task's WCETs) and one tick at level f retires work / wcet[f].
+// That keeps frequency changes in the middle of a job exact in integers.
+typedef struct {
+    sched_task task;
+    char *name;
+    uint64_t work;                     // units per job
+    uint64_t step[SCHED_NUM_FREQS];    // units retired per tick at each level
+} TaskInfo;
+
+typedef struct {
+    int task_id;
+    uint64_t release_time;
+    uint64_t abs_deadline;
+    uint64_t remaining;   // work units left
+    uint64_t job_seq;     // 0,1,2,... per task
+} Job;
+
+struct sched_ctx {
+    sched_policy policy;
+    sched_allocator alloc;
+
+    TaskInfo *tasks;
+    uint64_t *next_seq;
+    uint64_t *dpm_next_d; // scratch for edf_delay, one slot per task
+    int num_tasks, cap_tasks, cap_seq, cap_next_d;
+
+    Job *ready;           // ready queue as a simple array
+    int ready_count, ready_cap;
+
+    bool cpu_busy;
+    Job current;
+
+    sched_freq_mode freq_mode;
+    int fixed_level;
+    int freq;
+    bool freq_dirty;
+    double power_active[SCHED_NUM_FREQS];
+    double power_idle;
+
+    sched_dpm_mode dpm_mode;
+    sched_sleep_state sleep[SCHED_MAX_SLEEP];
+    int num_sleep;
+    bool dpm_dirty;       // dpm_delay needs recomputing
+    uint64_t dpm_delay;   // how long new work may be held back
+    int dpm_state;        // sleep state, -1 while awake
+    bool dpm_waking;
+    uint64_t dpm_wake;    // first tick of the wake-up transition
+    uint64_t dpm_hold;    // no job starts before this tick
+    uint64_t dpm_quiet;   // no sleep decision needed before this tick
+
+    sched_event_fn on_event;
+    void *event_user;
+    sched_demand_fn demand;
+    void *demand_user;
+
+    sched_stats stats;
+};
+
+// ---------- Allocation ----------
+static void *default_alloc(void *user, size_t size){ (void)user; return malloc(size); }
+static void default_free(void *user, void *ptr){ (void)user; free(ptr); }
+
+static void *ctx_alloc(sched_ctx *ctx, size_t size){
+    return ctx->alloc.alloc(ctx->alloc.user, size);
+}
+static void ctx_free(sched_ctx *ctx, void *ptr){
+    if (ptr) ctx->alloc.free(ctx->alloc.user, ptr);
+}
+
+// Grows *arr (elem bytes each) to hold at least need elements.
+static bool ctx_grow(sched_ctx *ctx, void **arr, int *cap, int need, size_t elem){
+    if (need <= *cap) return true;
+    int ncap = *cap ? *cap * 2 : 8;
+    while (ncap < need) ncap *= 2;
+    void *p = ctx_alloc(ctx, (size_t)ncap * elem);
+    if (!p) return false;
+    if (*arr) memcpy(p, *arr, (size_t)*cap * elem);
+    ctx_free(ctx, *arr);
+    *arr = p;
+    *cap = ncap;
+    return true;
+}
+
+// ---------- Lifetime ----------
+sched_ctx *sched_create(sched_policy policy, const sched_allocator *alloc){
+    sched_allocator a = { default_alloc, default_free, NULL };
+    if (alloc && alloc->alloc && alloc->free) a = *alloc;
+    if (policy != SCHED_EDF && policy != SCHED_RM) return NULL;
+    sched_ctx *ctx = a.alloc(a.user, sizeof *ctx);
+    if (!ctx) return NULL;
+    memset(ctx, 0, sizeof *ctx);
+    ctx->policy = policy;
+    ctx->alloc = a;
+    ctx->freq_mode = SCHED_FREQ_FIXED;
+    ctx->dpm_state = -1;
+    return ctx;
+}
+
+void sched_destroy(sched_ctx *ctx){
+    if (!ctx) return;
+    for (int i = 0; i < ctx->num_tasks; ++i) ctx_free(ctx, ctx->tasks[i].name);
+    ctx_free(ctx, ctx->tasks);
+    ctx_free(ctx, ctx->next_seq);
+    ctx_free(ctx, ctx->dpm_next_d);
+    ctx_free(ctx, ctx->ready);
+    ctx->alloc.free(ctx->alloc.user, ctx);
+}
+
+// ---------- Tasks ----------
+static uint64_t gcd_u64(uint64_t a, uint64_t b){
+    while (b){ uint64_t r = a % b; a = b; b = r; }
+    return a;
+}
+
+int sched_add_task(sched_ctx *ctx, const sched_task *task){
+    if (!ctx || !task || task->period == 0) return SCHED_ERR_INVAL;
+    uint64_t work = 1;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        if (task->wcet[f] == 0) return SCHED_ERR_INVAL;
+        work = work / gcd_u64(work, task->wcet[f]) * task->wcet[f];
+        if (work > (UINT64_C(1) << 52)) return SCHED_ERR_INVAL;
+    }
+
+    if (!ctx_grow(ctx, (void **)&ctx->tasks, &ctx->cap_tasks, ctx->num_tasks + 1, sizeof(TaskInfo)) ||
+        !ctx_grow(ctx, (void **)&ctx->next_seq, &ctx->cap_seq, ctx->num_tasks + 1, sizeof(uint64_t)) ||
+        !ctx_grow(ctx, (void **)&ctx->dpm_next_d, &ctx->cap_next_d, ctx->num_tasks + 1,
+                  sizeof(uint64_t)))
+        return SCHED_ERR_NOMEM;
+
+    const char *src = task->name ? task->name : "";
+    size_t len = strlen(src) + 1;
+    char *name = ctx_alloc(ctx, len);
+    if (!name) return SCHED_ERR_NOMEM;
+    memcpy(name, src, len);
+
+    TaskInfo *ti = &ctx->tasks[ctx->num_tasks];
+    ti->task = *task;
+    ti->task.name = name;
+    if (ti->task.deadline == 0) ti->task.deadline = task->period;
+    ti->name = name;
+    ti->work = work;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f) ti->step[f] = work / task->wcet[f];
+    ctx->next_seq[ctx->num_tasks] = 0;
+    ctx->freq_dirty = true;
+    ctx->dpm_dirty = true;
+    return ctx->num_tasks++;
+}
+
+int sched_num_tasks(const sched_ctx *ctx){
+    return ctx ? ctx->num_tasks : 0;
+}
+
+const sched_task *sched_get_task(const sched_ctx *ctx, int task_id){
+    if (!ctx || task_id < 0 || task_id >= ctx->num_tasks) return NULL;
+    return &ctx->tasks[task_id].task;
+}
+
+// Same format as PA3.py: "numTasks T_end P1188 P918 P648 P384 Pidle", then
+// "name period wcet1188 wcet918 wcet648 wcet384" per task.
+int sched_load_input(sched_ctx *ctx, const char *path, uint64_t *t_end){
+    if (!ctx || !path) return SCHED_ERR_INVAL;
+    FILE *f = fopen(path, "r");
+    if (!f) return SCHED_ERR_IO;
+    int n;
+    unsigned long long end;
+    double active[SCHED_NUM_FREQS], idle;
+    int rc = SCHED_OK;
+    if (fscanf(f, "%d %llu %lf %lf %lf %lf %lf", &n, &end,
+               &active[0], &active[1], &active[2], &active[3], &idle) != 7 || n < 0){
+        rc = SCHED_ERR_IO;
+    }
+    for (int i = 0; rc == SCHED_OK && i < n; ++i){
+        char name[64];
+        sched_task t = {0};
+        if (fscanf(f, "%63s %u %u %u %u %u", name, &t.period,
+                   &t.wcet[0], &t.wcet[1], &t.wcet[2], &t.wcet[3]) != 6){
+            rc = SCHED_ERR_IO;
+            break;
+        }
+        t.name = name;
+        int id = sched_add_task(ctx, &t);
+        if (id < 0) rc = id;
+    }
+    fclose(f);
+    if (rc == SCHED_OK){
+        sched_set_power(ctx, active, idle);
+        if (t_end) *t_end = end;
+    }
+    return rc;
+}
+
+// ---------- Configuration ----------
+int sched_set_power(sched_ctx *ctx, const double active[SCHED_NUM_FREQS], double idle){
+    if (!ctx || !active) return SCHED_ERR_INVAL;
+    memcpy(ctx->power_active, active, sizeof ctx->power_active);
+    ctx->power_idle = idle;
+    return SCHED_OK;
+}
+
+int sched_get_power(const sched_ctx *ctx, double active[SCHED_NUM_FREQS], double *idle){
+    if (!ctx || !active || !idle) return SCHED_ERR_INVAL;
+    memcpy(active, ctx->power_active, sizeof ctx->power_active);
+    *idle = ctx->power_idle;
+    return SCHED_OK;
+}
+
+int sched_set_freq(sched_ctx *ctx, sched_freq_mode mode, int level){
+    if (!ctx || (mode != SCHED_FREQ_FIXED && mode != SCHED_FREQ_EE)) return SCHED_ERR_INVAL;
+    if (mode == SCHED_FREQ_FIXED && (level < 0 || level >= SCHED_NUM_FREQS)) return SCHED_ERR_INVAL;
+    ctx->freq_mode = mode;
+    ctx->fixed_level = level;
+    ctx->freq_dirty = true;
+    return SCHED_OK;
+}
+
+int sched_current_freq(const sched_ctx *ctx){
+    return ctx ? ctx->freq : SCHED_ERR_INVAL;
+}
+
+int sched_set_dpm(sched_ctx *ctx, sched_dpm_mode mode, const sched_sleep_state *states, int n){
+    if (!ctx || n < 0 || n > SCHED_MAX_SLEEP || (n > 0 && !states)) return SCHED_ERR_INVAL;
+    if (mode != SCHED_DPM_OFF && mode != SCHED_DPM_GREEDY && mode != SCHED_DPM_PROCRASTINATE)
+        return SCHED_ERR_INVAL;
+    for (int i = 0; i < n; ++i)
+        if (states[i].power < 0.0) return SCHED_ERR_INVAL;
+    if (n > 0) memcpy(ctx->sleep, states, (size_t)n * sizeof *states);
+    ctx->num_sleep = n;
+    ctx->dpm_mode = mode;
+    ctx->dpm_dirty = true;
+    return SCHED_OK;
+}
+
+void sched_set_event_callback(sched_ctx *ctx, sched_event_fn fn, void *user){
+    if (!ctx) return;
+    ctx->on_event = fn;
+    ctx->event_user = user;
+}
+
+void sched_set_demand_callback(sched_ctx *ctx, sched_demand_fn fn, void *user){
+    if (!ctx) return;
+    ctx->demand = fn;
+    ctx->demand_user = user;
+}
+
+// Static EE choice: the slowest level whose utilization passes the policy's
+// bound (1 for EDF, Liu & Layland for RM); the fastest level otherwise.
+static int ee_level(const sched_ctx *ctx){
+    double bound = 1.0;
+    if (ctx->policy == SCHED_RM && ctx->num_tasks > 0)
+        bound = ctx->num_tasks * (pow(2.0, 1.0 / ctx->num_tasks) - 1.0);
+    for (int f = SCHED_NUM_FREQS - 1; f > 0; --f){
+        double u = 0.0;
+        for (int i = 0; i < ctx->num_tasks; ++i)
+            u += (double)ctx->tasks[i].task.wcet[f] / ctx->tasks[i].task.period;
+        if (u <= bound) return f;
+    }
+    return 0;
+}
+
+// ---------- Procrastination ----------
+// How long the first job after an idle instant may be held back without a
+// miss, at the current level. Nothing is pending at an idle instant, so the
+// synchronous release at the first arrival is the worst case and the delay
+// acts like a blocking term.
+
+// EDF: the delay Z must satisfy dbf(L) <= L - Z at every absolute deadline L.
+// L - dbf(L) >= L (1 - U) - sum U_i (T_i - D_i), which bounds the scan.
+#define DPM_EDF_MAX_POINTS 1000000
+
+static uint64_t edf_delay(const sched_ctx *ctx){
+    int n = ctx->num_tasks, f = ctx->freq;
+    double u = 0.0, tail = 0.0;
+    for (int i = 0; i < n; ++i){
+        const sched_task *t = &ctx->tasks[i].task;
+        double ui = (double)t->wcet[f] / t->period;
+        u += ui;
+        tail += ui * ((double)t->period - (double)t->deadline);
+    }
+    if (n == 0 || u >= 1.0) return 0;
+
+    uint64_t *next_d = ctx->dpm_next_d;   // next checkpoint of each task
+    for (int i = 0; i < n; ++i) next_d[i] = ctx->tasks[i].task.deadline;
+    double best = INFINITY;
+    uint64_t demand = 0;
+    for (int k = 0; k < DPM_EDF_MAX_POINTS; ++k){
+        uint64_t l = UINT64_MAX;
+        for (int i = 0; i < n; ++i) if (next_d[i] < l) l = next_d[i];
+        if (u < 1.0 && (double)l * (1.0 - u) - tail >= best) break;
+        for (int i = 0; i < n; ++i){
+            if (next_d[i] == l){
+                demand += ctx->tasks[i].task.wcet[f];
+                next_d[i] += ctx->tasks[i].task.period;
+            }
+        }
+        if (demand > l) return 0;
+        if ((double)(l - demand) < best) best = (double)(l - demand);
+        if (k + 1 == DPM_EDF_MAX_POINTS) return 0;   // unresolved: do not delay
+    }
+    return (uint64_t)best;
+}
+
+// RM: largest blocking B with every response time within its deadline.
+// Equal periods count as higher priority, which is conservative. Arbitrary
+// deadlines (D_i > T_i) are not analysed: no delay.
+static bool rm_fits(const sched_ctx *ctx, uint64_t b){
+    int f = ctx->freq;
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const sched_task *ti = &ctx->tasks[i].task;
+        uint64_t r = b + ti->wcet[f], prev = 0;
+        while (r != prev && r <= ti->deadline){
+            prev = r;
+            r = b + ti->wcet[f];
+            for (int j = 0; j < ctx->num_tasks; ++j){
+                const sched_task *tj = &ctx->tasks[j].task;
+                if (j != i && tj->period <= ti->period)
+                    r += (prev + tj->period - 1) / tj->period * tj->wcet[f];
+            }
+        }
+        if (r > ti->deadline) return false;
+    }
+    return true;
+}
+
+static uint64_t rm_delay(const sched_ctx *ctx){
+    uint64_t hi = UINT64_MAX;
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const sched_task *t = &ctx->tasks[i].task;
+        if (t->deadline > t->period) return 0;
+        if (t->deadline < hi) hi = t->deadline;
+    }
+    if (ctx->num_tasks == 0 || !rm_fits(ctx, 0)) return 0;
+    uint64_t lo = 0;   // rm_fits(lo) holds, rm_fits(hi) does not
+    while (hi - lo > 1){
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (rm_fits(ctx, mid)) lo = mid; else hi = mid;
+    }
+    return lo;
+}
+
+// ---------- Ready queue ----------
+static bool rq_push(sched_ctx *ctx, Job j){
+    if (!ctx_grow(ctx, (void **)&ctx->ready, &ctx->ready_cap, ctx->ready_count + 1, sizeof(Job)))
+        return false;
+    ctx->ready[ctx->ready_count++] = j;
+    return true;
+}
+
+static void rq_remove_idx(sched_ctx *ctx, int idx){
+    if (idx < 0 || idx >= ctx->ready_count) return;
+    ctx->ready[idx] = ctx->ready[--ctx->ready_count];
+}
+
+static int rq_earliest_deadline_idx(const sched_ctx *ctx){
+    PROF_SCAN(ctx->ready_count);
+    if (ctx->ready_count == 0) return -1;
+    int best = 0;
+    for (int i = 1; i < ctx->ready_count; ++i)
+        if (ctx->ready[i].abs_deadline < ctx->ready[best].abs_deadline) best = i;
+    return best;
+}
+
+// RM: smaller period => higher priority. Tie: earlier deadline, then smaller task_id.
+static int rq_highest_rm_idx(const sched_ctx *ctx){
+    PROF_SCAN(ctx->ready_count);
+    if (ctx->ready_count == 0) return -1;
+    const Job *rq = ctx->ready;
+    int best = 0;
+    for (int i = 1; i < ctx->ready_count; ++i){
+        int a = rq[i].task_id, b = rq[best].task_id;
+        uint32_t pa = ctx->tasks[a].task.period, pb = ctx->tasks[b].task.period;
+        if (pa < pb) best = i;
+        else if (pa == pb){
+            if (rq[i].abs_deadline < rq[best].abs_deadline) best = i;
+            else if (rq[i].abs_deadline == rq[best].abs_deadline && a < b) best = i;
+        }
+    }
+    return best;
+}
+
+static void emit(sched_ctx *ctx, sched_event_type type, const Job *j){
+    if (!ctx->on_event) return;
+    sched_event ev;
+    ev.type = type;
+    ev.time = ctx->stats.now;
+    ev.task_id = j ? j->task_id : -1;
+    ev.job_seq = j ? j->job_seq : 0;
+    ev.release_time = j ? j->release_time : 0;
+    ev.abs_deadline = j ? j->abs_deadline : 0;
+    ev.freq = ctx->freq;
+    ev.state = ctx->dpm_state;
+    PROF_BEGIN(trace);
+    ctx->on_event(ctx->event_user, &ev);
+    PROF_END(trace, PH_TRACE);
+}
+
+static uint64_t next_release(const sched_ctx *ctx, uint64_t t){
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const sched_task *ti = &ctx->tasks[i].task;
+        uint64_t r = (t < ti->phase) ? ti->phase
+                   : ti->phase + ((t - ti->phase) / ti->period + 1) * ti->period;
+        if (r < next) next = r;
+    }
+    return next;
+}
+
+// Called at the first idle tick t with nothing pending: picks the sleep
+// state for the whole interval up to the next start.
+static void dpm_begin_idle(sched_ctx *ctx, uint64_t t){
+    if (ctx->dpm_dirty){
+        ctx->dpm_delay = 0;
+        if (ctx->dpm_mode == SCHED_DPM_PROCRASTINATE)
+            ctx->dpm_delay = (ctx->policy == SCHED_EDF) ? edf_delay(ctx) : rm_delay(ctx);
+        ctx->stats.dpm_delay = ctx->dpm_delay;
+        ctx->dpm_dirty = false;
+    }
+    uint64_t arrival = next_release(ctx, t);
+    ctx->dpm_quiet = arrival;
+    if (arrival == UINT64_MAX) return;
+    uint64_t len = arrival + ctx->dpm_delay - t;
+
+    int best = -1;
+    double best_energy = (double)len * ctx->power_idle;
+    for (int s = 0; s < ctx->num_sleep; ++s){
+        const sched_sleep_state *st = &ctx->sleep[s];
+        if (st->break_even > len || st->wake_latency > len) continue;
+        double e = (double)(len - st->wake_latency) * st->power +
+                   (double)st->wake_latency * ctx->power_active[ctx->freq];
+        if (e < best_energy){
+            best_energy = e;
+            best = s;
+        }
+    }
+    if (best < 0) return;   // stay awake; do not hold work back for nothing
+    ctx->dpm_state = best;
+    ctx->dpm_waking = false;
+    ctx->dpm_hold = t + len;
+    ctx->dpm_wake = ctx->dpm_hold - ctx->sleep[best].wake_latency;
+    ctx->dpm_quiet = ctx->dpm_hold;
+    ctx->stats.sleep_entries[best]++;
+    emit(ctx, SCHED_EV_SLEEP, NULL);
+    if (ctx->dpm_wake == t){
+        ctx->dpm_waking = true;
+        emit(ctx, SCHED_EV_WAKE, NULL);
+    }
+}
+
+// ---------- Simulation ----------
+int sched_step(sched_ctx *ctx){
+    if (!ctx) return SCHED_ERR_INVAL;
+    uint64_t t = ctx->stats.now;
+    PROF_STEP();
+
+    // 0) Frequency level
+    PROF_BEGIN(dvfs);
+    if (ctx->freq_dirty){
+        int f = (ctx->freq_mode == SCHED_FREQ_EE) ? ee_level(ctx) : ctx->fixed_level;
+        ctx->freq_dirty = false;
+        if (f != ctx->freq){
+            ctx->freq = f;
+            emit(ctx, SCHED_EV_FREQ, NULL);
+        }
+        ctx->dpm_dirty = true;
+    }
+    PROF_END(dvfs, PH_DVFS);
+
+    // Wake-up from a sleep state
+    PROF_BEGIN(wake);
+    if (ctx->dpm_state >= 0){
+        if (!ctx->dpm_waking && t >= ctx->dpm_wake){
+            ctx->dpm_waking = true;
+            emit(ctx, SCHED_EV_WAKE, NULL);
+        }
+        if (t >= ctx->dpm_hold) ctx->dpm_state = -1;
+    }
+    PROF_END(wake, PH_DPM);
+
+    // 1) Releases at time t
+    PROF_BEGIN(release);
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const TaskInfo *ti = &ctx->tasks[i];
+        if (t >= ti->task.phase && ((t - ti->task.phase) % ti->task.period == 0)){
+            Job j;
+            j.task_id = i;
+            j.release_time = t;
+            j.abs_deadline = t + ti->task.deadline;
+            j.job_seq = ctx->next_seq[i]++;
+            j.remaining = ti->work;
+            if (ctx->demand){
+                double frac = ctx->demand(ctx->demand_user, i, j.job_seq);
+                if (frac < 1.0) j.remaining = (uint64_t)ceil(frac * (double)ti->work);
+                if (j.remaining == 0) j.remaining = 1;
+            }
+            if (!rq_push(ctx, j)) return SCHED_ERR_NOMEM;
+            ctx->stats.released++;
+            emit(ctx, SCHED_EV_RELEASE, &j);
+        }
+    }
+    PROF_END(release, PH_RELEASE);
+
+    // 2) Deadline misses: late jobs are dropped
+    PROF_BEGIN(miss);
+    if (ctx->cpu_busy && t > ctx->current.abs_deadline && ctx->current.remaining > 0){
+        emit(ctx, SCHED_EV_MISS, &ctx->current);
+        ctx->stats.misses++;
+        ctx->cpu_busy = false;
+    }
+    for (int i = 0; i < ctx->ready_count; ++i){
+        if (t > ctx->ready[i].abs_deadline && ctx->ready[i].remaining > 0){
+            emit(ctx, SCHED_EV_MISS, &ctx->ready[i]);
+            ctx->stats.misses++;
+            rq_remove_idx(ctx, i);
+            i--; // Adjust index after removal
+        }
+    }
+    PROF_END(miss, PH_MISS);
+
+    // 3) Start or preempt according to policy
+    PROF_BEGIN(select);
+    int idx = (ctx->policy == SCHED_EDF) ? rq_earliest_deadline_idx(ctx)
+                                         : rq_highest_rm_idx(ctx);
+    if (!ctx->cpu_busy){
+        if (idx != -1 && ctx->dpm_state < 0){
+            ctx->current = ctx->ready[idx];
+            rq_remove_idx(ctx, idx);
+            ctx->cpu_busy = true;
+            emit(ctx, SCHED_EV_START, &ctx->current);
+        }
+    } else if (idx != -1){
+        const Job *best = &ctx->ready[idx];
+        bool preempt = (ctx->policy == SCHED_EDF)
+            ? best->abs_deadline < ctx->current.abs_deadline
+            : ctx->tasks[best->task_id].task.period <
+              ctx->tasks[ctx->current.task_id].task.period;
+        if (preempt){
+            if (!rq_push(ctx, ctx->current)) return SCHED_ERR_NOMEM;
+            ctx->current = ctx->ready[idx];
+            rq_remove_idx(ctx, idx);
+            ctx->stats.preemptions++;
+            emit(ctx, SCHED_EV_PREEMPT, &ctx->current);
+        }
+    }
+    PROF_END(select, PH_SELECT);
+
+    if (!ctx->cpu_busy && ctx->dpm_state < 0 && ctx->dpm_mode != SCHED_DPM_OFF &&
+        t >= ctx->dpm_quiet){
+        PROF_BEGIN(dpm);
+        dpm_begin_idle(ctx, t);
+        PROF_END(dpm, PH_DPM);
+    }
+
+    // 4) Execute the running job
+    PROF_BEGIN(execute);
+    ctx->stats.now = t + 1;
+    if (ctx->cpu_busy){
+        uint64_t step = ctx->tasks[ctx->current.task_id].step[ctx->freq];
+        ctx->current.remaining = (ctx->current.remaining > step) ? ctx->current.remaining - step : 0;
+        ctx->stats.busy_ticks++;
+        ctx->stats.freq_ticks[ctx->freq]++;
+        ctx->stats.energy_busy += ctx->power_active[ctx->freq];
+        if (ctx->current.remaining == 0){
+            ctx->stats.completed++;
+            ctx->cpu_busy = false;
+            emit(ctx, SCHED_EV_COMPLETE, &ctx->current);
+        }
+    } else {
+        ctx->stats.idle_ticks++;
+        int s = ctx->dpm_state;
+        if (s < 0){
+            ctx->stats.energy_idle += ctx->power_idle;
+        } else if (t < ctx->dpm_wake){
+            ctx->stats.sleep_ticks[s]++;
+            ctx->stats.energy_sleep[s] += ctx->sleep[s].power;
+        } else {
+            ctx->stats.wake_ticks++;
+            ctx->stats.energy_wake += ctx->power_active[ctx->freq];
+        }
+    }
+    PROF_END(execute, PH_EXECUTE);
+    return SCHED_OK;
+}
+
+int sched_is_idle(const sched_ctx *ctx){
+    return ctx && !ctx->cpu_busy && ctx->ready_count == 0 && ctx->dpm_state < 0;
+}
+
+int sched_seek_idle(sched_ctx *ctx, uint64_t t){
+    if (!ctx || ctx->dpm_mode != SCHED_DPM_OFF) return SCHED_ERR_INVAL;
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const sched_task *ti = &ctx->tasks[i].task;
+        // Releases in [0, t): phase + k T < t
+        ctx->next_seq[i] = (t > ti->phase) ? (t - ti->phase + ti->period - 1) / ti->period : 0;
+    }
+    ctx->ready_count = 0;
+    ctx->cpu_busy = false;
+    memset(&ctx->stats, 0, sizeof ctx->stats);
+    ctx->stats.now = t;
+    return SCHED_OK;
+}
+
+int sched_run_until(sched_ctx *ctx, uint64_t end){
+    if (!ctx) return SCHED_ERR_INVAL;
+    while (ctx->stats.now < end){
+        int rc = sched_step(ctx);
+        if (rc != SCHED_OK) return rc;
+    }
+    return SCHED_OK;
+}
+
+void sched_get_stats(const sched_ctx *ctx, sched_stats *out){
+    if (!ctx || !out) return;
+    *out = ctx->stats;
+}
+
+// ---------- Configuration hash ----------
+// Two independently seeded multiply-xorshift streams over 64-bit words.
+typedef struct { uint64_t h[2]; } Hasher;
+
+static uint64_t mix64(uint64_t x){
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static void hash_u64(Hasher *hs, uint64_t v){
+    hs->h[0] = mix64(hs->h[0] ^ v) + 0x9e3779b97f4a7c15ULL;
+    hs->h[1] = mix64(hs->h[1] + v * 0xbf58476d1ce4e5b9ULL) ^ 0x94d049bb133111ebULL;
+}
+
+static void hash_double(Hasher *hs, double d){
+    uint64_t v;
+    if (d == 0.0) d = 0.0;   // -0.0 and 0.0 are the same figure
+    memcpy(&v, &d, sizeof v);
+    hash_u64(hs, v);
+}
+
+int sched_config_hash(const sched_ctx *ctx, uint64_t end, uint64_t out[2]){
+    if (!ctx || !out || ctx->stats.now != 0 || ctx->demand) return SCHED_ERR_INVAL;
+    Hasher hs = { { 0x243f6a8885a308d3ULL, 0x13198a2e03707344ULL } };
+    hash_u64(&hs, SCHED_ENGINE_VERSION);
+    hash_u64(&hs, sizeof(sched_stats));
+    hash_u64(&hs, end);
+    hash_u64(&hs, (uint64_t)ctx->policy);
+    hash_u64(&hs, (uint64_t)ctx->freq_mode);
+    hash_u64(&hs, ctx->freq_mode == SCHED_FREQ_FIXED ? (uint64_t)ctx->fixed_level : 0);
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f) hash_double(&hs, ctx->power_active[f]);
+    hash_double(&hs, ctx->power_idle);
+    hash_u64(&hs, (uint64_t)ctx->dpm_mode);
+    int nsleep = (ctx->dpm_mode == SCHED_DPM_OFF) ? 0 : ctx->num_sleep;
+    hash_u64(&hs, (uint64_t)nsleep);
+    for (int s = 0; s < nsleep; ++s){
+        hash_double(&hs, ctx->sleep[s].power);
+        hash_u64(&hs, ctx->sleep[s].wake_latency);
+        hash_u64(&hs, ctx->sleep[s].break_even);
+    }
+    hash_u64(&hs, (uint64_t)ctx->num_tasks);
+    for (int i = 0; i < ctx->num_tasks; ++i){
+        const sched_task *t = &ctx->tasks[i].task;
+        hash_u64(&hs, t->period);
+        for (int f = 0; f < SCHED_NUM_FREQS; ++f) hash_u64(&hs, t->wcet[f]);
+        hash_u64(&hs, t->deadline);   // already normalized: 0 became the period
+        hash_u64(&hs, t->phase);
+    }
+    out[0] = mix64(hs.h[0] ^ hs.h[1]);
+    out[1] = mix64(hs.h[1] + out[0]);
+    return SCHED_OK;
+}
+
+const char *sched_strerror(int code){
+    switch (code){
+    case SCHED_OK:        return "ok";
+    case SCHED_ERR_INVAL: return "invalid argument";
+    case SCHED_ERR_NOMEM: return "out of memory";
+    case SCHED_ERR_IO:    return "cannot read input";
+    default:              return "unknown error";
+    }
+}
@@ -0,0 +1,182 @@
+// sched_lib.h
+// libsched: reentrant EDF/RM (optionally energy-efficient) scheduling engine.
+// Build (static): gcc -O2 -std=c11 -c sched_lib.c && ar rcs libsched.a sched_lib.o
+// Build (shared): gcc -O2 -std=c11 -shared -fPIC sched_lib.c -o libsched.so -lm
+// Link:           gcc app.c -L. -lsched -lm
+// Profile:        add -DSCHED_PROFILE to time each phase of the tick loop
+//
+// Same tick semantics as EDF.cpp / RM_Scheduler.c, but every piece of state
+// lives in a sched_ctx: no globals, nothing printed. A context may be used by
+// one thread at a time; different contexts are independent, so many threads
+// can each drive their own.
+//
+//   sched_ctx *c = sched_create(SCHED_EDF, NULL);
+//   sched_add_task(c, &(sched_task){ "T1", 5, {1, 1, 2, 3}, 5, 0 });
+//   sched_run_until(c, 1000);
+//   sched_stats st; sched_get_stats(c, &st);
+//   sched_destroy(c);
+
+#ifndef SCHED_LIB_H
+#define SCHED_LIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_NUM_FREQS 4  // 1188, 918, 648, 384 MHz (test_input.txt order)
+#define SCHED_MAX_SLEEP 4  // sleep states for dynamic power management
+
+// Bump whenever the same configuration may produce different results or
+// sched_stats changes layout; cached results (sched_cache.h) keyed on an
+// older version are discarded.
+#define SCHED_ENGINE_VERSION 1
+
+// Return codes
+#define SCHED_OK          0
+#define SCHED_ERR_INVAL  -1
+#define SCHED_ERR_NOMEM  -2
+#define SCHED_ERR_IO     -3
+
+typedef enum { SCHED_EDF, SCHED_RM } sched_policy;
+
+typedef enum {
+    SCHED_FREQ_FIXED,  // always run at one level
+    SCHED_FREQ_EE      // slowest level whose utilization passes the policy's bound
+} sched_freq_mode;
+
+// Dynamic power management. At the start of every idle interval the engine
+// knows when the next job arrives (releases are periodic) and enters the
+// sleep state that costs least over the interval, among those whose
+// break-even time and wake-up latency fit. Waking up takes wake_latency
+// ticks at the current active power and ends exactly when work resumes.
+typedef enum {
+    SCHED_DPM_OFF,           // idle ticks cost power_idle
+    SCHED_DPM_GREEDY,        // sleep through each idle interval as it comes
+    SCHED_DPM_PROCRASTINATE  // also hold new jobs back as long as no deadline
+                             // can be missed, to merge idle intervals
+} sched_dpm_mode;
+
+typedef struct {
+    double power;            // while asleep
+    uint32_t wake_latency;   // ticks
+    uint32_t break_even;     // shortest idle interval worth entering it for
+} sched_sleep_state;
+
+typedef struct {
+    void *(*alloc)(void *user, size_t size);
+    void  (*free)(void *user, void *ptr);
+    void *user;
+} sched_allocator;
+
+typedef struct {
+    const char *name;                 // copied by sched_add_task
+    uint32_t period;                  // T_i
+    uint32_t wcet[SCHED_NUM_FREQS];   // C_i (ticks) at each frequency level
+    uint32_t deadline;                // D_i (relative), 0 means D_i = T_i
+    uint32_t phase;                   // release offset
+} sched_task;
+
+typedef enum {
+    SCHED_EV_RELEASE,
+    SCHED_EV_START,
+    SCHED_EV_PREEMPT,   // task_id/job_seq: the job that takes the CPU
+    SCHED_EV_COMPLETE,  // time is the end of the last executed tick
+    SCHED_EV_MISS,      // the job is dropped, as in the simulators
+    SCHED_EV_FREQ,      // frequency level changed to freq
+    SCHED_EV_SLEEP,     // CPU entered sleep state `state`
+    SCHED_EV_WAKE       // CPU started waking up from `state`
+} sched_event_type;
+
+typedef struct {
+    sched_event_type type;
+    uint64_t time;
+    int task_id;
+    uint64_t job_seq;
+    uint64_t release_time;
+    uint64_t abs_deadline;
+    int freq;           // frequency level in effect
+    int state;          // sleep state, -1 while awake
+} sched_event;
+
+typedef struct {
+    uint64_t now;       // next tick to execute
+    uint64_t released;
+    uint64_t completed;
+    uint64_t preemptions;
+    uint64_t misses;
+    uint64_t busy_ticks;
+    uint64_t idle_ticks;                   // every tick not executing a job
+    uint64_t freq_ticks[SCHED_NUM_FREQS];  // busy ticks per level
+    uint64_t sleep_ticks[SCHED_MAX_SLEEP]; // idle ticks asleep, per state
+    uint64_t sleep_entries[SCHED_MAX_SLEEP];
+    uint64_t wake_ticks;                   // idle ticks spent waking up
+    uint64_t dpm_delay;                    // procrastination interval in use
+    double energy_busy;
+    double energy_idle;                    // idle and awake only
+    double energy_sleep[SCHED_MAX_SLEEP];
+    double energy_wake;
+} sched_stats;
+
+typedef struct sched_ctx sched_ctx;
+
+// Called for every scheduling event, synchronously from sched_step.
+typedef void (*sched_event_fn)(void *user, const sched_event *ev);
+// Actual demand of a new job as a fraction of its WCET, in (0, 1].
+// Without a callback every job runs for exactly its WCET.
+typedef double (*sched_demand_fn)(void *user, int task_id, uint64_t job_seq);
+
+// alloc may be NULL (malloc/free). Returns NULL on allocation failure.
+sched_ctx *sched_create(sched_policy policy, const sched_allocator *alloc);
+void sched_destroy(sched_ctx *ctx);
+
+// Returns the new task id (>= 0) or a SCHED_ERR_* code.
+int sched_add_task(sched_ctx *ctx, const sched_task *task);
+int sched_num_tasks(const sched_ctx *ctx);
+const sched_task *sched_get_task(const sched_ctx *ctx, int task_id);
+
+// Loads tasks and power figures from a test_input.txt-style file.
+// *t_end (may be NULL) receives the execution time from the header.
+int sched_load_input(sched_ctx *ctx, const char *path, uint64_t *t_end);
+
+int sched_set_power(sched_ctx *ctx, const double active[SCHED_NUM_FREQS], double idle);
+int sched_get_power(const sched_ctx *ctx, double active[SCHED_NUM_FREQS], double *idle);
+int sched_set_freq(sched_ctx *ctx, sched_freq_mode mode, int level);
+int sched_current_freq(const sched_ctx *ctx);
+// Copies n (<= SCHED_MAX_SLEEP) states; takes effect at the next idle interval.
+int sched_set_dpm(sched_ctx *ctx, sched_dpm_mode mode, const sched_sleep_state *states, int n);
+void sched_set_event_callback(sched_ctx *ctx, sched_event_fn fn, void *user);
+void sched_set_demand_callback(sched_ctx *ctx, sched_demand_fn fn, void *user);
+
+// Executes one tick.
+int sched_step(sched_ctx *ctx);
+
+// An idle instant is the start of a tick with no job running or pending.
+// The state there depends on the time alone, so a run can be started at
+// any idle instant t without simulating [0, t): sched_seek_idle puts a
+// context in that state (statistics count from t). Not available with DPM.
+int sched_is_idle(const sched_ctx *ctx);
+int sched_seek_idle(sched_ctx *ctx, uint64_t t);
+// Executes ticks until now == end (the simulators' "t <= END" is end = END + 1).
+int sched_run_until(sched_ctx *ctx, uint64_t end);
+
+void sched_get_stats(const sched_ctx *ctx, sched_stats *out);
+// 128-bit hash of everything that determines the result of running a fresh
+// context to end: engine version, policy, frequency and DPM settings, power
+// figures and the tasks in order (order decides ties). Names are ignored.
+// SCHED_ERR_INVAL once the context has run or with a demand callback set.
+int sched_config_hash(const sched_ctx *ctx, uint64_t end, uint64_t out[2]);
+const char *sched_strerror(int code);
+
+// Per-phase timings and ready-queue counters of every thread (also printed
+// to stderr at exit). Does nothing unless built with -DSCHED_PROFILE.
+void sched_profile_dump(FILE *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_LIB_H
@@ -0,0 +1,236 @@
+// sched_trace.c
+// Timeline export of a libsched run in Chrome Trace Event JSON, which opens
+// in ui.perfetto.dev and chrome://tracing.
+// Build: gcc -O2 -std=c11 sched_trace.c sched_lib.c -o sched_trace -lm
+// Run:   ./sched_trace [edf|rm] [input_file] [out.json] [--ee] [--end T] [--tick-us US]
+//
+// Tracks:
+//   CPU / cpu0     one slice per contiguous execution of a job (split on
+//                  preemption and frequency change), plus "freq_MHz" and
+//                  "power" counters, so idle-energy gaps are visible
+//   Tasks / <name> release and deadline markers and deadline misses
+// Events are written as they happen; only the currently running slice is
+// kept in memory, so multi-million-event runs stream in constant space.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sched_lib.h"
+
+#define CPU_PID   1
+#define TASK_PID  2
+
+static const int FREQUENCIES[SCHED_NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    FILE *out;
+    const sched_ctx *ctx;
+    double tick_us;            // microseconds per tick
+    double power[SCHED_NUM_FREQS], power_idle;
+    bool first;                // no comma before the first event
+
+    bool running;              // open execution slice
+    int task_id;
+    uint64_t job_seq, abs_deadline, since;
+    int freq;
+} Exporter;
+
+static void begin_event(Exporter *ex){
+    fputs(ex->first ? "\n" : ",\n", ex->out);
+    ex->first = false;
+}
+
+// Task names come from input files; escape what JSON requires.
+static void put_string(FILE *out, const char *s){
+    fputc('"', out);
+    for (; *s; ++s){
+        if (*s == '"' || *s == '\\') fputc('\\', out);
+        if ((unsigned char)*s >= 0x20) fputc(*s, out);
+    }
+    fputc('"', out);
+}
+
+static const char *task_name(const Exporter *ex, int task_id){
+    const sched_task *t = sched_get_task(ex->ctx, task_id);
+    return t ? t->name : "?";
+}
+
+static void counter(Exporter *ex, const char *name, uint64_t t, double value){
+    begin_event(ex);
+    fprintf(ex->out, "{\"ph\":\"C\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"name\":\"%s\","
+                     "\"args\":{\"value\":%.3f}}",
+            CPU_PID, t * ex->tick_us, name, value);
+}
+
+static void instant(Exporter *ex, const char *name, int task_id, uint64_t t,
+                    uint64_t job_seq, uint64_t abs_deadline){
+    begin_event(ex);
+    fprintf(ex->out, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"name\":\"%s\","
+                     "\"args\":{\"job\":%llu,\"deadline\":%llu}}",
+            TASK_PID, task_id + 1, t * ex->tick_us, name,
+            (unsigned long long)job_seq, (unsigned long long)abs_deadline);
+}
+
+static void slice_begin(Exporter *ex, const sched_event *ev){
+    bool was_idle = !ex->running;
+    ex->running = true;
+    ex->task_id = ev->task_id;
+    ex->job_seq = ev->job_seq;
+    ex->abs_deadline = ev->abs_deadline;
+    ex->since = ev->time;
+    ex->freq = ev->freq;
+    if (was_idle) counter(ex, "power", ev->time, ex->power[ev->freq]);
+}
+
+static void slice_end(Exporter *ex, uint64_t t, const char *why){
+    if (!ex->running) return;
+    ex->running = false;
+    if (t == ex->since) return;
+    begin_event(ex);
+    fprintf(ex->out, "{\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+            CPU_PID, ex->since * ex->tick_us, (t - ex->since) * ex->tick_us);
+    put_string(ex->out, task_name(ex, ex->task_id));
+    fprintf(ex->out, ",\"args\":{\"job\":%llu,\"deadline\":%llu,\"freq_MHz\":%d,\"end\":\"%s\"}}",
+            (unsigned long long)ex->job_seq, (unsigned long long)ex->abs_deadline,
+            FREQUENCIES[ex->freq], why);
+}
+
+static void on_event(void *user, const sched_event *ev){
+    Exporter *ex = user;
+    switch (ev->type){
+    case SCHED_EV_RELEASE:
+        instant(ex, "release", ev->task_id, ev->time, ev->job_seq, ev->abs_deadline);
+        instant(ex, "deadline", ev->task_id, ev->abs_deadline, ev->job_seq, ev->abs_deadline);
+        break;
+    case SCHED_EV_START:
+        slice_begin(ex, ev);
+        break;
+    case SCHED_EV_PREEMPT:
+        slice_end(ex, ev->time, "preempted");
+        slice_begin(ex, ev);
+        break;
+    case SCHED_EV_COMPLETE:
+        slice_end(ex, ev->time, "complete");
+        counter(ex, "power", ev->time, ex->power_idle);
+        break;
+    case SCHED_EV_MISS:
+        if (ex->running && ex->task_id == ev->task_id && ex->job_seq == ev->job_seq){
+            slice_end(ex, ev->time, "missed");
+            counter(ex, "power", ev->time, ex->power_idle);
+        }
+        instant(ex, "MISS", ev->task_id, ev->time, ev->job_seq, ev->abs_deadline);
+        break;
+    case SCHED_EV_FREQ:
+        counter(ex, "freq_MHz", ev->time, FREQUENCIES[ev->freq]);
+        if (ex->running){
+            sched_event cont = *ev;
+            cont.task_id = ex->task_id;
+            cont.job_seq = ex->job_seq;
+            cont.abs_deadline = ex->abs_deadline;
+            slice_end(ex, ev->time, "frequency change");
+            slice_begin(ex, &cont);
+            counter(ex, "power", ev->time, ex->power[ev->freq]);
+        }
+        break;
+    case SCHED_EV_SLEEP:
+    case SCHED_EV_WAKE:
+        break;   // DPM is not enabled here
+    }
+}
+
+static void metadata(Exporter *ex, int pid, int tid, const char *kind, const char *name){
+    begin_event(ex);
+    fprintf(ex->out, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":",
+            pid, tid, kind);
+    put_string(ex->out, name);
+    fputs("}}", ex->out);
+}
+
+int main(int argc, char **argv){
+    sched_policy pol = SCHED_EDF;
+    const char *input = "test_input.txt", *output = NULL;
+    bool ee = false;
+    uint64_t end = 0;
+    double tick_us = 1000.0;   // test_input.txt times are in milliseconds
+    const char *pos[3];
+    int npos = 0;
+
+    for (int i = 1; i < argc; ++i){
+        if (strcmp(argv[i], "--ee") == 0) ee = true;
+        else if (strcmp(argv[i], "--end") == 0 && i + 1 < argc) end = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--tick-us") == 0 && i + 1 < argc) tick_us = atof(argv[++i]);
+        else if (argv[i][0] != '-' && npos < 3) pos[npos++] = argv[i];
+        else npos = -1;
+        if (npos < 0) break;
+    }
+    int k = 0;
+    if (npos > 0 && (strcmp(pos[0], "edf") == 0 || strcmp(pos[0], "rm") == 0)){
+        pol = (strcmp(pos[0], "edf") == 0) ? SCHED_EDF : SCHED_RM;
+        k++;
+    }
+    if (npos > k) input = pos[k++];
+    if (npos > k) output = pos[k++];
+    if (npos < 0 || k != npos || tick_us <= 0.0){
+        fprintf(stderr, "Usage: %s [edf|rm] [input_file] [out.json] [--ee] [--end T] [--tick-us US]\n",
+                argv[0]);
+        return 1;
+    }
+
+    sched_ctx *ctx = sched_create(pol, NULL);
+    uint64_t t_end = 0;
+    int rc = ctx ? sched_load_input(ctx, input, &t_end) : SCHED_ERR_NOMEM;
+    if (rc != SCHED_OK){
+        fprintf(stderr, "Cannot load %s: %s\n", input, sched_strerror(rc));
+        sched_destroy(ctx);
+        return 1;
+    }
+    if (end) t_end = end;
+    if (ee) sched_set_freq(ctx, SCHED_FREQ_EE, 0);
+
+    Exporter ex;
+    memset(&ex, 0, sizeof ex);
+    ex.out = output ? fopen(output, "w") : stdout;
+    if (!ex.out){
+        fprintf(stderr, "Cannot write %s\n", output);
+        sched_destroy(ctx);
+        return 1;
+    }
+    static char buf[1 << 20];
+    setvbuf(ex.out, buf, _IOFBF, sizeof buf);
+    ex.ctx = ctx;
+    ex.tick_us = tick_us;
+    ex.first = true;
+
+    sched_get_power(ctx, ex.power, &ex.power_idle);
+
+    fputs("[", ex.out);
+    metadata(&ex, CPU_PID, 0, "process_name", "CPU");
+    metadata(&ex, CPU_PID, 0, "thread_name", "cpu0");
+    metadata(&ex, TASK_PID, 0, "process_name", "Tasks");
+    for (int i = 0; i < sched_num_tasks(ctx); ++i)
+        metadata(&ex, TASK_PID, i + 1, "thread_name", task_name(&ex, i));
+    counter(&ex, "freq_MHz", 0, FREQUENCIES[0]);
+    counter(&ex, "power", 0, ex.power_idle);
+
+    sched_set_event_callback(ctx, on_event, &ex);
+    rc = sched_run_until(ctx, t_end);
+    slice_end(&ex, t_end, "end of run");
+    fputs("\n]\n", ex.out);
+
+    sched_stats st;
+    sched_get_stats(ctx, &st);
+    fprintf(stderr, "Traced %llu ticks: Completed=%llu, Preemptions=%llu, Misses=%llu\n",
+            (unsigned long long)st.now, (unsigned long long)st.completed,
+            (unsigned long long)st.preemptions, (unsigned long long)st.misses);
+    // A full disk or a closed pipe leaves truncated JSON: fail loudly.
+    bool written = fflush(ex.out) == 0 && !ferror(ex.out);
+    if (ex.out != stdout && fclose(ex.out) != 0) written = false;
+    sched_destroy(ctx);
+    if (!written){
+        fprintf(stderr, "Cannot write %s\n", output ? output : "stdout");
+        return 1;
+    }
+    return rc == SCHED_OK ? 0 : 1;
+}
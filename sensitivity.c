@@ -0,0 +1,238 @@
+// sensitivity.c
+// Breakdown-utilization and WCET sensitivity of a task set under EDF and RM,
+// reported for each DVFS level of the four-frequency WCET table.
+// Build: gcc -O2 -std=c11 -pthread sensitivity.c -o sensitivity -lm
+// Run:   ./sensitivity [input_file] [threads]     (default test_input.txt)
+//
+// For every (frequency, policy) pair it reports
+//   - breakdown scale: largest uniform factor s so that s*C_i stays schedulable
+//   - per-task WCET slack: extra ticks task i alone can take
+//   - per-task minimum period (implicit deadline) before a miss
+// Each quantity is a binary search over an analytical schedulability test
+// (EDF: U <= 1; RM: Liu & Layland bound, then response-time analysis),
+// both exact since the input format gives D_i = T_i.
+// The searches are independent, so they are spread over a pool of threads.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define MAX_TASKS   32
+#define NUM_FREQS   4
+#define MAX_THREADS 64
+#define SCALE_EPS   1e-6
+
+typedef enum { POLICY_EDF, POLICY_RM } Policy;
+
+static const int FREQUENCIES[NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    char name[32];
+    uint32_t period;           // T_i
+    uint32_t wcet[NUM_FREQS];  // C_i at each frequency (test_input.txt order)
+    uint32_t deadline;         // D_i (relative) = T_i in the input format
+} Task;
+
+static Task tasks[MAX_TASKS];
+static int N = 0;
+
+// ---------- Input (same format as PA3.py) ----------
+static bool load_input(const char *path){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    int n;
+    long t_end, p[NUM_FREQS + 1];
+    bool ok = fscanf(f, "%d %ld %ld %ld %ld %ld %ld", &n, &t_end,
+                     &p[0], &p[1], &p[2], &p[3], &p[4]) == 7 &&
+              n > 0 && n <= MAX_TASKS;
+    for (int i = 0; ok && i < n; ++i){
+        Task *ti = &tasks[i];
+        ok = fscanf(f, "%31s %u %u %u %u %u", ti->name, &ti->period,
+                    &ti->wcet[0], &ti->wcet[1], &ti->wcet[2], &ti->wcet[3]) == 6 &&
+             ti->period > 0;
+        ti->deadline = ti->period;
+    }
+    fclose(f);
+    if (ok) N = n;
+    return ok;
+}
+
+// ---------- Schedulability tests ----------
+// A candidate task set: execution demand as doubles so that scaled WCETs need
+// no rounding, periods/deadlines as integers.
+typedef struct {
+    double   c[MAX_TASKS];
+    uint32_t t[MAX_TASKS];
+    uint32_t d[MAX_TASKS];
+} TaskSet;
+
+static double utilization(const TaskSet *ts){
+    double u = 0.0;
+    for (int i = 0; i < N; ++i) u += ts->c[i] / ts->t[i];
+    return u;
+}
+
+// RM priority order: smaller period first, then smaller index (same as
+// rq_highest_rm_idx in the simulators).
+static bool higher_rm(const TaskSet *ts, int a, int b){
+    if (ts->t[a] != ts->t[b]) return ts->t[a] < ts->t[b];
+    return a < b;
+}
+
+// EDF with D_i = T_i: U <= 1 is exact.
+static bool edf_test(const TaskSet *ts){
+    return utilization(ts) <= 1.0 + 1e-12;
+}
+
+// RM response-time analysis (exact for synchronous sets with D_i <= T_i).
+static bool rm_rta_test(const TaskSet *ts){
+    double u = utilization(ts);
+    if (u > 1.0 + 1e-12) return false;
+    if (u <= N * (pow(2.0, 1.0 / N) - 1.0)) return true;  // Liu & Layland
+
+    for (int i = 0; i < N; ++i){
+        double r = ts->c[i], prev = 0.0;
+        while (r != prev){
+            prev = r;
+            r = ts->c[i];
+            for (int j = 0; j < N; ++j)
+                if (j != i && higher_rm(ts, j, i)) r += ceil(prev / ts->t[j] - 1e-12) * ts->c[j];
+            if (r > ts->d[i] + 1e-9) return false;
+        }
+    }
+    return true;
+}
+
+static bool schedulable(const TaskSet *ts, Policy pol){
+    for (int i = 0; i < N; ++i) if (ts->c[i] > ts->d[i] + 1e-9) return false;
+    return (pol == POLICY_EDF) ? edf_test(ts) : rm_rta_test(ts);
+}
+
+static void base_set(TaskSet *ts, int freq){
+    for (int i = 0; i < N; ++i){
+        ts->c[i] = tasks[i].wcet[freq];
+        ts->t[i] = tasks[i].period;
+        ts->d[i] = tasks[i].deadline;
+    }
+}
+
+// ---------- Sensitivity searches ----------
+// Largest s with s*C_i schedulable for all i.
+static double breakdown_scale(int freq, Policy pol){
+    TaskSet base, ts;
+    base_set(&base, freq);
+    double lo = 0.0, hi = 1.0;
+    for (int i = 0; i < N; ++i) if (base.c[i] > 0) hi = fmax(hi, base.d[i] / base.c[i]);
+    while (hi - lo > SCALE_EPS * hi){
+        double mid = 0.5 * (lo + hi);
+        ts = base;
+        for (int i = 0; i < N; ++i) ts.c[i] = base.c[i] * mid;
+        if (schedulable(&ts, pol)) lo = mid; else hi = mid;
+    }
+    return lo;
+}
+
+// Extra ticks task k alone can take; -1 if the base set already misses.
+static long wcet_slack(int freq, Policy pol, int k){
+    TaskSet ts;
+    base_set(&ts, freq);
+    if (!schedulable(&ts, pol)) return -1;
+    long lo = 0, hi = (long)ts.d[k] - (long)tasks[k].wcet[freq] + 1;
+    while (hi - lo > 1){
+        long mid = lo + (hi - lo) / 2;
+        ts.c[k] = tasks[k].wcet[freq] + mid;
+        if (schedulable(&ts, pol)) lo = mid; else hi = mid;
+    }
+    return lo;
+}
+
+// Smallest period (= deadline) for task k alone; 0 if even T_k misses.
+// Under RM a shorter period also raises the task's priority; the search
+// assumes the result stays monotone, which holds for EDF and in practice RM.
+static long min_period(int freq, Policy pol, int k){
+    TaskSet ts;
+    base_set(&ts, freq);
+    if (!schedulable(&ts, pol)) return 0;
+    long lo = (long)tasks[k].wcet[freq] - 1, hi = tasks[k].period;
+    if (lo < 0) lo = 0;
+    while (hi - lo > 1){
+        long mid = lo + (hi - lo) / 2;
+        ts.t[k] = ts.d[k] = (uint32_t)mid;
+        if (mid > 0 && schedulable(&ts, pol)) hi = mid; else lo = mid;
+    }
+    return hi;
+}
+
+// ---------- Parallel driver ----------
+// One work item per (frequency, policy, quantity); quantity 0 is the
+// breakdown scale, 1..N the WCET slack of task q-1, N+1..2N the minimum period.
+typedef struct {
+    double scale[NUM_FREQS][2];
+    long slack[NUM_FREQS][2][MAX_TASKS];
+    long minT[NUM_FREQS][2][MAX_TASKS];
+} Results;
+
+static Results results;
+static atomic_int next_item;
+static int total_items;
+
+static void *worker(void *arg){
+    (void)arg;
+    int per = 2 * (1 + 2 * N);
+    for (int it; (it = atomic_fetch_add(&next_item, 1)) < total_items; ){
+        int freq = it / per, rest = it % per;
+        Policy pol = (Policy)(rest / (1 + 2 * N));
+        int q = rest % (1 + 2 * N);
+        if (q == 0) results.scale[freq][pol] = breakdown_scale(freq, pol);
+        else if (q <= N) results.slack[freq][pol][q - 1] = wcet_slack(freq, pol, q - 1);
+        else results.minT[freq][pol][q - 1 - N] = min_period(freq, pol, q - 1 - N);
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv){
+    const char *input = (argc >= 2) ? argv[1] : "test_input.txt";
+    int threads = (argc >= 3) ? atoi(argv[2]) : 4;
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (!load_input(input)){
+        fprintf(stderr, "Cannot read task set from %s\n", input);
+        return 1;
+    }
+
+    total_items = NUM_FREQS * 2 * (1 + 2 * N);
+    atomic_init(&next_item, 0);
+    pthread_t tid[MAX_THREADS];
+    int started = 0;
+    while (started < threads && pthread_create(&tid[started], NULL, worker, NULL) == 0)
+        started++;
+    if (started < threads) worker(NULL);   // no more threads: take the rest here
+    for (int i = 0; i < started; ++i) pthread_join(tid[i], NULL);
+
+    for (int f = 0; f < NUM_FREQS; ++f){
+        for (int p = 0; p < 2; ++p){
+            TaskSet ts;
+            base_set(&ts, f);
+            printf("=== %s @ %d MHz: U=%.4f  breakdown scale=%.4f  (breakdown U=%.4f) ===\n",
+                   p == POLICY_EDF ? "EDF" : "RM", FREQUENCIES[f], utilization(&ts),
+                   results.scale[f][p], utilization(&ts) * results.scale[f][p]);
+            for (int i = 0; i < N; ++i){
+                if (results.slack[f][p][i] < 0){
+                    printf("  %-8s C=%-4u T=%-5u  not schedulable\n",
+                           tasks[i].name, tasks[i].wcet[f], tasks[i].period);
+                } else {
+                    printf("  %-8s C=%-4u T=%-5u  WCET slack=%ld  min period=%ld\n",
+                           tasks[i].name, tasks[i].wcet[f], tasks[i].period,
+                           results.slack[f][p][i], results.minT[f][p][i]);
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,414 @@
+// thermal.c
+// Thermal model coupled to the energy simulation: an RC model of the die
+// driven by the power of every tick, temperature-dependent leakage, and
+// hardware throttling that takes the fast levels away above a threshold.
+// Build: gcc -O2 -std=c11 thermal.c sched_lib.c -o thermal -lm
+// Run:   ./thermal [edf|rm] [input_file] [--thermal FILE] [--end T]
+//        ./thermal edf thermal_input.txt --thermal thermal_params.txt
+//          (sample where 648 MHz is cheapest but runs hotter than 384 MHz:
+//          TA-EE static settles on 384, the governor runs 648/384)
+//
+// Model (first order, ambient Ta, leakage linear in temperature):
+//   C dT/dt = P_dyn + P_leak(T) - (T - Ta) / R,  P_leak(T) = L0 + k (T - Tref)
+// P_dyn is the test_input.txt figure of the current level, or the idle
+// figure, taken as mW. Between two events P_dyn is constant and the
+// equation is linear, so T(t) = T_inf + (T0 - T_inf) exp(-t / tau) with
+// tau = C / (1/R - k); leakage energy and the temperature integral have
+// closed forms too. The model is therefore only evaluated when the power
+// changes (start, completion, miss, frequency change) or when a threshold
+// is crossed, and that crossing time is itself solved in closed form
+// instead of being found by testing every tick.
+//
+// Policies compared:
+//   fixed level        the given level, throttled by the hardware
+//   EE                 static EE level (utilization bound), throttled
+//   TA-EE static       the cheapest level that passes the bound and, in the
+//                      runs above, met every deadline without throttling and
+//                      below the limit
+//   TA-EE governor     runs the cheapest level that passes the bound and
+//                      falls back to the one that ran coolest while the die
+//                      is above a guard temperature; both levels are
+//                      schedulable, so switching between them cannot cause
+//                      a miss
+//
+// Thermal file, "key value" per line (defaults in brackets): r [60] K/W,
+// c [0.03] J/K, ambient [45] C, initial [ambient] C, leak0 [60] mW at
+// t_ref [45] C, leak_slope [2] mW/K, tick [0.001] s, throttle_temp [80] C,
+// throttle_level [2], hysteresis [2] K, limit [75] C.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sched_lib.h"
+
+static const int FREQUENCIES[SCHED_NUM_FREQS] = {1188, 918, 648, 384}; // MHz
+
+typedef struct {
+    double r, c, ambient, initial;
+    double leak0, leak_slope, t_ref;   // W, W/K, C
+    double tick;                       // seconds per tick
+    double throttle_temp, hysteresis, limit;
+    int throttle_level;                // slowest level allowed to stay on when hot
+} Thermal;
+
+static Thermal th = {
+    .r = 60.0, .c = 0.03, .ambient = 45.0, .initial = NAN,
+    .leak0 = 0.060, .leak_slope = 0.002, .t_ref = 45.0, .tick = 0.001,
+    .throttle_temp = 80.0, .hysteresis = 2.0, .limit = 75.0, .throttle_level = 2,
+};
+
+static double power[SCHED_NUM_FREQS], power_idle;   // input units (mW)
+
+// ---------- Closed-form RC model ----------
+static double conductance(void){ return 1.0 / th.r - th.leak_slope; }
+static double time_constant(void){ return th.c / conductance(); }
+
+// Temperature reached under constant dynamic power p (W) after a long time
+static double steady_temp(double p){
+    return (p + th.leak0 - th.leak_slope * th.t_ref + th.ambient / th.r) / conductance();
+}
+
+// Seconds until the temperature, now t0 under power p, rises to (or, with
+// rising false, falls to) target: 0 when it is already there, INFINITY
+// when it never gets there.
+static double crossing_time(double t0, double p, double target, bool rising){
+    double tinf = steady_temp(p);
+    if (rising ? t0 >= target : t0 <= target) return 0.0;
+    if (rising ? tinf <= target : tinf >= target) return INFINITY;
+    return time_constant() * log((tinf - t0) / (tinf - target));
+}
+
+// ---------- Coupled run ----------
+typedef enum { POL_FIXED, POL_GOVERNOR } PolicyKind;
+
+typedef struct {
+    PolicyKind kind;
+    int level;              // POL_FIXED: the level; POL_GOVERNOR: preferred level
+    int cool_level;         // POL_GOVERNOR: level while above the guard
+    double guard;
+
+    // Thermal state as of tick t_last
+    uint64_t t_last;
+    double temp, peak, temp_integral;   // C, C, C*s
+    double e_leak;                      // J
+    double p_dyn;                       // W in effect since t_last
+    uint64_t updates;
+
+    // CPU state, mirrored from events
+    bool busy;
+    int cur_task;
+    uint64_t cur_seq;
+    int freq;
+
+    bool throttled, hot;
+    uint64_t throttle_since, throttle_ticks;
+    uint64_t next_check;                // tick of the next threshold crossing
+} Run;
+
+static void run_advance(Run *r, uint64_t t){
+    if (t <= r->t_last) return;
+    double dt = (double)(t - r->t_last) * th.tick;
+    double tau = time_constant(), tinf = steady_temp(r->p_dyn);
+    double decay = exp(-dt / tau);
+    double integral = tinf * dt + (r->temp - tinf) * tau * (1.0 - decay);
+    r->e_leak += (th.leak0 - th.leak_slope * th.t_ref) * dt + th.leak_slope * integral;
+    r->temp_integral += integral;
+    r->temp = tinf + (r->temp - tinf) * decay;
+    if (r->temp > r->peak) r->peak = r->temp;   // monotone between events
+    r->t_last = t;
+    r->updates++;
+}
+
+// Earliest tick at which a threshold the run is watching is crossed.
+static void run_schedule_check(Run *r){
+    double next = r->throttled
+                ? crossing_time(r->temp, r->p_dyn, th.throttle_temp - th.hysteresis, false)
+                : crossing_time(r->temp, r->p_dyn, th.throttle_temp, true);
+    if (r->kind == POL_GOVERNOR){
+        double g = r->hot ? crossing_time(r->temp, r->p_dyn, r->guard - th.hysteresis, false)
+                          : crossing_time(r->temp, r->p_dyn, r->guard, true);
+        if (g < next) next = g;
+    }
+    double ticks = ceil(next / th.tick);
+    r->next_check = (ticks > 1e18) ? UINT64_MAX : r->t_last + (uint64_t)ticks;
+}
+
+static void run_set_power(Run *r){
+    double p = r->busy ? power[r->freq] : power_idle;
+    r->p_dyn = p * 1e-3;
+    run_schedule_check(r);
+}
+
+static void on_event(void *user, const sched_event *ev){
+    Run *r = user;
+    switch (ev->type){
+    case SCHED_EV_START:
+    case SCHED_EV_PREEMPT:
+        run_advance(r, ev->time);
+        r->busy = true;
+        r->cur_task = ev->task_id;
+        r->cur_seq = ev->job_seq;
+        break;
+    case SCHED_EV_COMPLETE:
+        run_advance(r, ev->time);
+        r->busy = false;
+        break;
+    case SCHED_EV_MISS:
+        if (!r->busy || ev->task_id != r->cur_task || ev->job_seq != r->cur_seq) return;
+        run_advance(r, ev->time);   // the running job was dropped
+        r->busy = false;
+        break;
+    case SCHED_EV_FREQ:
+        run_advance(r, ev->time);
+        r->freq = ev->freq;
+        break;
+    default:
+        return;
+    }
+    run_set_power(r);
+}
+
+// Applies throttling and the governor at tick t (before it executes).
+static void run_check(Run *r, sched_ctx *ctx, uint64_t t){
+    run_advance(r, t);
+    if (!r->throttled && r->temp >= th.throttle_temp){
+        r->throttled = true;
+        r->throttle_since = t;
+    } else if (r->throttled && r->temp <= th.throttle_temp - th.hysteresis){
+        r->throttled = false;
+        r->throttle_ticks += t - r->throttle_since;
+    }
+    if (r->kind == POL_GOVERNOR){
+        if (!r->hot && r->temp >= r->guard) r->hot = true;
+        else if (r->hot && r->temp <= r->guard - th.hysteresis) r->hot = false;
+    }
+    int want = (r->kind == POL_GOVERNOR && r->hot) ? r->cool_level : r->level;
+    if (r->throttled && want < th.throttle_level) want = th.throttle_level;
+    sched_set_freq(ctx, SCHED_FREQ_FIXED, want);   // FREQ event, if any, at t
+    run_schedule_check(r);
+}
+
+typedef struct {
+    uint64_t misses, updates, throttle_ticks, hot_ticks;
+    double peak, mean, e_dyn, e_leak;   // energies in input units x ticks
+} Result;
+
+static bool simulate(const char *input, sched_policy pol, uint64_t end, Run *r, Result *out){
+    sched_ctx *ctx = sched_create(pol, NULL);
+    int rc = ctx ? sched_load_input(ctx, input, NULL) : SCHED_ERR_NOMEM;
+    if (rc != SCHED_OK){
+        fprintf(stderr, "Cannot run %s: %s\n", input, sched_strerror(rc));
+        sched_destroy(ctx);
+        return false;
+    }
+    r->t_last = 0;
+    r->temp = r->peak = th.initial;
+    r->temp_integral = r->e_leak = 0.0;
+    r->updates = 0;
+    r->busy = r->throttled = r->hot = false;
+    r->throttle_ticks = 0;
+    r->freq = sched_current_freq(ctx);   // FREQ events report changes from here
+    sched_set_event_callback(ctx, on_event, r);
+    run_set_power(r);
+    r->next_check = 0;
+
+    for (uint64_t t = 0; t < end; ++t){
+        if (t >= r->next_check) run_check(r, ctx, t);
+        if ((rc = sched_step(ctx)) != SCHED_OK) break;
+    }
+    if (rc == SCHED_OK){
+        run_advance(r, end);
+        if (r->throttled) r->throttle_ticks += end - r->throttle_since;
+        sched_stats st;
+        sched_get_stats(ctx, &st);
+        out->misses = st.misses;
+        out->updates = r->updates;
+        out->throttle_ticks = r->throttle_ticks;
+        out->peak = r->peak;
+        out->mean = end ? r->temp_integral / ((double)end * th.tick) : r->temp;
+        out->e_dyn = st.energy_busy + st.energy_idle;
+        out->e_leak = r->e_leak * 1e3 / th.tick;   // J -> mW x ticks
+    } else {
+        fprintf(stderr, "Simulation failed: %s\n", sched_strerror(rc));
+    }
+    sched_destroy(ctx);
+    return rc == SCHED_OK;
+}
+
+// ---------- Level analysis ----------
+// Same test as libsched's EE level: utilization against the policy's bound.
+static bool level_passes(const sched_ctx *ctx, sched_policy pol, int f){
+    int n = sched_num_tasks(ctx);
+    double bound = (pol == SCHED_RM && n > 0) ? n * (pow(2.0, 1.0 / n) - 1.0) : 1.0;
+    double u = 0.0;
+    for (int i = 0; i < n; ++i){
+        const sched_task *t = sched_get_task(ctx, i);
+        u += (double)t->wcet[f] / t->period;
+    }
+    return u <= bound;
+}
+
+static bool load_thermal(const char *path){
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+    char key[32];
+    double v;
+    bool ok = true;
+    while (ok && fscanf(f, "%31s %lf", key, &v) == 2){
+        if (strcmp(key, "r") == 0) th.r = v;
+        else if (strcmp(key, "c") == 0) th.c = v;
+        else if (strcmp(key, "ambient") == 0) th.ambient = v;
+        else if (strcmp(key, "initial") == 0) th.initial = v;
+        else if (strcmp(key, "leak0") == 0) th.leak0 = v * 1e-3;
+        else if (strcmp(key, "t_ref") == 0) th.t_ref = v;
+        else if (strcmp(key, "leak_slope") == 0) th.leak_slope = v * 1e-3;
+        else if (strcmp(key, "tick") == 0) th.tick = v;
+        else if (strcmp(key, "throttle_temp") == 0) th.throttle_temp = v;
+        else if (strcmp(key, "throttle_level") == 0) th.throttle_level = (int)v;
+        else if (strcmp(key, "hysteresis") == 0) th.hysteresis = v;
+        else if (strcmp(key, "limit") == 0) th.limit = v;
+        else {
+            fprintf(stderr, "Unknown thermal parameter %s in %s\n", key, path);
+            ok = false;
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+static void print_row(const char *label, const char *mhz, const Result *res, uint64_t end){
+    printf("  %-16s %-9s %7llu %7.2f %7.2f %9.2f%% %13.2f %12.2f %13.2f\n", label, mhz,
+           (unsigned long long)res->misses, res->peak, res->mean,
+           end ? 100.0 * res->throttle_ticks / end : 0.0, res->e_dyn, res->e_leak,
+           res->e_dyn + res->e_leak);
+}
+
+int main(int argc, char **argv){
+    sched_policy pol = SCHED_EDF;
+    const char *input = "test_input.txt";
+    uint64_t end = 0;
+    int k = 1;
+    if (k < argc && (strcmp(argv[k], "edf") == 0 || strcmp(argv[k], "rm") == 0)){
+        pol = (strcmp(argv[k], "edf") == 0) ? SCHED_EDF : SCHED_RM;
+        k++;
+    }
+    if (k < argc && argv[k][0] != '-') input = argv[k++];
+    for (; k < argc; ++k){
+        if (strcmp(argv[k], "--thermal") == 0 && k + 1 < argc){
+            if (!load_thermal(argv[++k])){
+                fprintf(stderr, "Cannot read thermal parameters from %s\n", argv[k]);
+                return 1;
+            }
+        } else if (strcmp(argv[k], "--end") == 0 && k + 1 < argc){
+            end = strtoull(argv[++k], NULL, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [edf|rm] [input_file] [--thermal FILE] [--end T]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (isnan(th.initial)) th.initial = th.ambient;
+    if (conductance() <= 0.0 || th.c <= 0.0 || th.tick <= 0.0 ||
+        th.throttle_level < 0 || th.throttle_level >= SCHED_NUM_FREQS){
+        fprintf(stderr, "Invalid thermal parameters (leakage slope must stay below 1/R)\n");
+        return 1;
+    }
+
+    sched_ctx *ctx = sched_create(pol, NULL);
+    uint64_t t_end = 0;
+    int rc = ctx ? sched_load_input(ctx, input, &t_end) : SCHED_ERR_NOMEM;
+    if (rc != SCHED_OK){
+        fprintf(stderr, "Cannot read task set from %s: %s\n", input, sched_strerror(rc));
+        sched_destroy(ctx);
+        return 1;
+    }
+    sched_get_power(ctx, power, &power_idle);
+    double tau = time_constant();
+    if (!end){
+        // Shorter runs never get near a steady temperature
+        end = t_end + 1;
+        uint64_t settle = (uint64_t)ceil(10.0 * tau / th.tick);
+        if (settle > end) end = settle;
+    }
+
+    printf("Thermal model: R=%.2f K/W, C=%.4f J/K, tau=%.3f s, ambient %.1f C, start %.1f C\n",
+           th.r, th.c, tau, th.ambient, th.initial);
+    printf("Leakage: %.1f mW at %.1f C, %+.2f mW/K; tick %.4f s\n", th.leak0 * 1e3, th.t_ref,
+           th.leak_slope * 1e3, th.tick);
+    printf("Throttling at %.1f C to <= %d MHz (released at %.1f C); limit %.1f C\n",
+           th.throttle_temp, FREQUENCIES[th.throttle_level], th.throttle_temp - th.hysteresis,
+           th.limit);
+
+    bool passes[SCHED_NUM_FREQS];
+    printf("\n  %-9s %8s %15s\n", "level", "bound", "steady C @100%");
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        passes[f] = level_passes(ctx, pol, f);
+        printf("  %4d MHz  %8s %15.2f\n", FREQUENCIES[f], passes[f] ? "passes" : "fails",
+               steady_temp(power[f] * 1e-3));
+    }
+    sched_destroy(ctx);
+
+    printf("\n=== %s: t < %llu (%.1f s), energy in input units x ticks ===\n",
+           pol == SCHED_EDF ? "EDF" : "RM", (unsigned long long)end, end * th.tick);
+    printf("  %-16s %-9s %7s %7s %7s %10s %13s %12s %13s\n", "policy", "MHz", "misses", "peak C",
+           "mean C", "throttled", "dynamic", "leakage", "total");
+    Result fixed[SCHED_NUM_FREQS], res;
+    uint64_t updates = 0;
+    int runs = 0;
+    char mhz[16];
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        Run r = { .kind = POL_FIXED, .level = f };
+        if (!simulate(input, pol, end, &r, &fixed[f])) return 1;
+        snprintf(mhz, sizeof mhz, "%d", FREQUENCIES[f]);
+        print_row("fixed", mhz, &fixed[f], end);
+        updates += fixed[f].updates;
+        runs++;
+    }
+
+    // EE: slowest level that passes. TA-EE static: cheapest level that
+    // passes and ran without a miss or throttling, below the limit.
+    // Governor: cheapest level that passes, and the coolest one as fallback.
+    int ee = 0, safe = -1, best = -1, coolest = -1;
+    for (int f = 0; f < SCHED_NUM_FREQS; ++f){
+        if (!passes[f]) continue;
+        const Result *x = &fixed[f];
+        double total = x->e_dyn + x->e_leak;
+        ee = f;
+        if (best < 0 || total < fixed[best].e_dyn + fixed[best].e_leak) best = f;
+        if (coolest < 0 || x->peak < fixed[coolest].peak) coolest = f;
+        if (x->misses == 0 && x->throttle_ticks == 0 && x->peak < th.limit &&
+            (safe < 0 || total < fixed[safe].e_dyn + fixed[safe].e_leak))
+            safe = f;
+    }
+    snprintf(mhz, sizeof mhz, "%d", FREQUENCIES[ee]);
+    print_row("EE", mhz, &fixed[ee], end);
+    if (safe >= 0){
+        snprintf(mhz, sizeof mhz, "%d", FREQUENCIES[safe]);
+        print_row("TA-EE static", mhz, &fixed[safe], end);
+    } else {
+        printf("  %-16s no level that passes the bound stays below %.1f C\n", "TA-EE static",
+               th.limit);
+    }
+    if (best >= 0){
+        // Switch early enough that one more tick at the preferred level
+        // cannot overshoot the limit.
+        double rise = (steady_temp(power[best] * 1e-3) - th.ambient) * (1.0 - exp(-th.tick / tau));
+        Run r = { .kind = POL_GOVERNOR, .level = best, .cool_level = coolest,
+                  .guard = th.limit - rise };
+        if (!simulate(input, pol, end, &r, &res)) return 1;
+        snprintf(mhz, sizeof mhz, "%d/%d", FREQUENCIES[best], FREQUENCIES[coolest]);
+        print_row("TA-EE governor", mhz, &res, end);
+        updates += res.updates;
+        runs++;
+        if (fixed[coolest].peak >= th.limit)
+            printf("  (governor: even the coolest level that passes the bound, %d MHz, "
+                   "peaks above %.1f C)\n", FREQUENCIES[coolest], th.limit);
+    } else {
+        printf("  %-16s no level passes the bound\n", "TA-EE governor");
+    }
+    printf("Thermal model evaluated %llu times for %llu simulated ticks\n",
+           (unsigned long long)updates, (unsigned long long)end * runs);
+    return 0;
+}